@@ -0,0 +1,365 @@
+#include <benchmark/benchmark.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "s21_matrix_oop.hpp"
+
+// Every allocation of the library is counted: the C kernels through the
+// linker wrappers of malloc and calloc (-Wl,--wrap), the C++ side through
+// the global operator new.
+namespace {
+std::atomic<long> allocations{0};
+}  // namespace
+
+extern "C" {
+void* __real_malloc(std::size_t size);
+void* __real_calloc(std::size_t count, std::size_t size);
+
+void* __wrap_malloc(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(std::size_t count, std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real_calloc(count, size);
+}
+}
+
+// Kept out of line, so that GCC does not pair the inlined __real_malloc
+// with the free below and warn about mismatched allocation functions.
+[[gnu::noinline]] void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void* pointer = __real_malloc(size > 0 ? size : 1);
+  if (pointer == nullptr) throw std::bad_alloc();
+  return pointer;
+}
+
+[[gnu::noinline]] void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+
+namespace {
+
+enum Shape { kSquare, kTall, kWide };
+
+// Argument 0 is the size, 1 the shape and 2 the number of OpenMP threads.
+// Tall and wide matrices keep about size * size elements.
+struct Operands {
+  int rows, cols;
+};
+
+Operands Dimensions(const benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  int half = std::max(1, size / 2);
+  switch (state.range(1)) {
+    case kTall:
+      return {2 * size, half};
+    case kWide:
+      return {half, 2 * size};
+    default:
+      return {size, size};
+  }
+}
+
+S21Matrix Random(int rows, int cols, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) result(i, j) = uniform(generator);
+  }
+  return result;
+}
+
+// Runs kernel once per iteration and reports FLOP/s, bytes/s and the
+// allocations made per iteration.
+template <class Kernel>
+void Measure(benchmark::State& state, double flops, double bytes,
+             Kernel kernel) {
+  omp_set_num_threads(static_cast<int>(state.range(2)));
+  long before = allocations.load();
+  for (auto _ : state) kernel(state);
+  long counted = allocations.load() - before;
+  if (flops > 0) {
+    state.counters["FLOP/s"] = benchmark::Counter(
+        flops, benchmark::Counter::kIsIterationInvariantRate,
+        benchmark::Counter::OneK::kIs1000);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+  state.counters["allocs/iter"] = benchmark::Counter(
+      static_cast<double>(counted), benchmark::Counter::kAvgIterations);
+  static const char* const kShapes[] = {"square", "tall", "wide"};
+  state.SetLabel(kShapes[state.range(1)]);
+}
+
+// The operand that MulMatrix and *= overwrite is refreshed outside of the
+// timed region, and its allocations are not counted either.
+S21Matrix UntimedCopy(benchmark::State& state, const S21Matrix& matrix) {
+  state.PauseTiming();
+  long before = allocations.load();
+  S21Matrix copy(matrix);
+  allocations.fetch_sub(allocations.load() - before);
+  state.ResumeTiming();
+  return copy;
+}
+
+std::vector<int64_t> Threads() {
+  std::vector<int64_t> threads;
+  for (int count = 1; count <= omp_get_num_procs(); count *= 2) {
+    threads.push_back(count);
+  }
+  return threads;
+}
+
+// Sizes 1 to 4096 in every shape.
+void AllShapes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgsProduct({{1, 4, 16, 64, 256, 1024, 4096},
+                          {kSquare, kTall, kWide},
+                          Threads()});
+  benchmark->ArgNames({"size", "shape", "threads"})->UseRealTime();
+}
+
+// Determinant, CalcComplements and InverseMatrix expand cofactors, which
+// takes factorial time; larger sizes would not finish.
+void CofactorSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgsProduct({{2, 3, 4, 6, 8}, {kSquare}, Threads()});
+  benchmark->ArgNames({"size", "shape", "threads"})->UseRealTime();
+}
+
+double Factorial(int size) {
+  double result = 1;
+  for (int i = 2; i <= size; i++) result *= i;
+  return result;
+}
+
+void BM_MulMatrix(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(cols, rows, 2);
+  Measure(state, 2.0 * rows * cols * rows,
+          8.0 * (2.0 * rows * cols + rows * rows), [&](benchmark::State& s) {
+            S21Matrix c = UntimedCopy(s, a);
+            c.MulMatrix(b);
+            benchmark::DoNotOptimize(c);
+          });
+}
+
+void BM_OperatorMul(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(cols, rows, 2);
+  Measure(state, 2.0 * rows * cols * rows,
+          8.0 * (2.0 * rows * cols + rows * rows),
+          [&](benchmark::State&) { benchmark::DoNotOptimize(a * b); });
+}
+
+void BM_OperatorMulAssign(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(cols, cols, 2);
+  Measure(state, 2.0 * rows * cols * cols,
+          8.0 * (2.0 * rows * cols + cols * cols), [&](benchmark::State& s) {
+            S21Matrix c = UntimedCopy(s, a);
+            c *= b;
+            benchmark::DoNotOptimize(c);
+          });
+}
+
+void BM_SumMatrix(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(rows, cols, 2);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 24.0 * elements,
+          [&](benchmark::State&) { a.SumMatrix(b); });
+}
+
+void BM_SubMatrix(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(rows, cols, 2);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 24.0 * elements,
+          [&](benchmark::State&) { a.SubMatrix(b); });
+}
+
+void BM_OperatorPlus(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(rows, cols, 2);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 24.0 * elements,
+          [&](benchmark::State&) { benchmark::DoNotOptimize(a + b); });
+}
+
+void BM_OperatorMinus(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(rows, cols, 2);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 24.0 * elements,
+          [&](benchmark::State&) { benchmark::DoNotOptimize(a - b); });
+}
+
+void BM_OperatorPlusAssign(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(rows, cols, 2);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 24.0 * elements,
+          [&](benchmark::State&) { a += b; });
+}
+
+void BM_OperatorMinusAssign(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b = Random(rows, cols, 2);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 24.0 * elements,
+          [&](benchmark::State&) { a -= b; });
+}
+
+void BM_MulNumber(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 16.0 * elements,
+          [&](benchmark::State&) { a.MulNumber(-1.0); });
+}
+
+void BM_OperatorMulNumber(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 16.0 * elements,
+          [&](benchmark::State&) { benchmark::DoNotOptimize(a * -1.0); });
+}
+
+void BM_OperatorMulNumberAssign(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 16.0 * elements,
+          [&](benchmark::State&) { a *= -1.0; });
+}
+
+void BM_EqMatrix(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b(a);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 16.0 * elements, [&](benchmark::State&) {
+    benchmark::DoNotOptimize(a.EqMatrix(b));
+  });
+}
+
+void BM_OperatorEq(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b(a);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 16.0 * elements,
+          [&](benchmark::State&) { benchmark::DoNotOptimize(a == b); });
+}
+
+void BM_OperatorAssign(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1), b;
+  double elements = 1.0 * rows * cols;
+  Measure(state, 0, 16.0 * elements, [&](benchmark::State&) {
+    b = a;
+    benchmark::DoNotOptimize(b);
+  });
+}
+
+void BM_OperatorCall(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1);
+  double elements = 1.0 * rows * cols;
+  Measure(state, elements, 8.0 * elements, [&](benchmark::State&) {
+    double sum = 0;
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) sum += a(i, j);
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+void BM_Transpose(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1);
+  Measure(state, 0, 16.0 * rows * cols, [&](benchmark::State&) {
+    benchmark::DoNotOptimize(a.Transpose());
+  });
+}
+
+// One iteration grows the matrix by a row or column and shrinks it back.
+void BM_SetRows(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1);
+  Measure(state, 0, 32.0 * rows * cols, [&](benchmark::State&) {
+    a.set_rows(rows + 1);
+    a.set_rows(rows);
+  });
+}
+
+void BM_SetCols(benchmark::State& state) {
+  auto [rows, cols] = Dimensions(state);
+  S21Matrix a = Random(rows, cols, 1);
+  Measure(state, 0, 32.0 * rows * cols, [&](benchmark::State&) {
+    a.set_cols(cols + 1);
+    a.set_cols(cols);
+  });
+}
+
+void BM_Determinant(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix a = Random(size, size, 1);
+  Measure(state, Factorial(size), 8.0 * size * size, [&](benchmark::State&) {
+    benchmark::DoNotOptimize(a.Determinant());
+  });
+}
+
+void BM_CalcComplements(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix a = Random(size, size, 1);
+  Measure(state, size * size * Factorial(size - 1), 16.0 * size * size,
+          [&](benchmark::State&) {
+            benchmark::DoNotOptimize(a.CalcComplements());
+          });
+}
+
+void BM_InverseMatrix(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+  S21Matrix a = Random(size, size, 1);
+  Measure(state, (size * size + 1) * Factorial(size - 1), 16.0 * size * size,
+          [&](benchmark::State&) {
+            benchmark::DoNotOptimize(a.InverseMatrix());
+          });
+}
+
+}  // namespace
+
+BENCHMARK(BM_MulMatrix)->Apply(AllShapes);
+BENCHMARK(BM_OperatorMul)->Apply(AllShapes);
+BENCHMARK(BM_OperatorMulAssign)->Apply(AllShapes);
+BENCHMARK(BM_SumMatrix)->Apply(AllShapes);
+BENCHMARK(BM_SubMatrix)->Apply(AllShapes);
+BENCHMARK(BM_OperatorPlus)->Apply(AllShapes);
+BENCHMARK(BM_OperatorMinus)->Apply(AllShapes);
+BENCHMARK(BM_OperatorPlusAssign)->Apply(AllShapes);
+BENCHMARK(BM_OperatorMinusAssign)->Apply(AllShapes);
+BENCHMARK(BM_MulNumber)->Apply(AllShapes);
+BENCHMARK(BM_OperatorMulNumber)->Apply(AllShapes);
+BENCHMARK(BM_OperatorMulNumberAssign)->Apply(AllShapes);
+BENCHMARK(BM_EqMatrix)->Apply(AllShapes);
+BENCHMARK(BM_OperatorEq)->Apply(AllShapes);
+BENCHMARK(BM_OperatorAssign)->Apply(AllShapes);
+BENCHMARK(BM_OperatorCall)->Apply(AllShapes);
+BENCHMARK(BM_Transpose)->Apply(AllShapes);
+BENCHMARK(BM_SetRows)->Apply(AllShapes);
+BENCHMARK(BM_SetCols)->Apply(AllShapes);
+BENCHMARK(BM_Determinant)->Apply(CofactorSizes);
+BENCHMARK(BM_CalcComplements)->Apply(CofactorSizes);
+BENCHMARK(BM_InverseMatrix)->Apply(CofactorSizes);
+
+BENCHMARK_MAIN();
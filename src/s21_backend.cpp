@@ -0,0 +1,37 @@
+#include "s21_backend.hpp"
+
+#include <stdexcept>
+
+namespace {
+
+const s21_backend_t* Find(const std::string& name) {
+  const s21_backend_t* backend = s21_backend_find(name.c_str());
+  if (backend == nullptr) throw std::runtime_error("Unknown backend");
+  return backend;
+}
+
+}  // namespace
+
+std::vector<std::string> S21Backend::Available() {
+  std::vector<std::string> names;
+  for (int i = 0; i < s21_backend_count(); i++) {
+    names.emplace_back(s21_backend_at(i)->name);
+  }
+  return names;
+}
+
+std::string S21Backend::Current() { return s21_backend_current()->name; }
+
+void S21Backend::Select(const std::string& name) {
+  if (s21_backend_select(Find(name)) != OK)
+    throw std::runtime_error("Backend failed the self-check");
+}
+
+bool S21Backend::SelfCheck(const std::string& name) {
+  return s21_backend_self_check(Find(name), s21_backend_builtin()) == OK;
+}
+
+S21BackendScope::S21BackendScope(const std::string& name)
+    : previous_(s21_backend_override(Find(name))) {}
+
+S21BackendScope::~S21BackendScope() { s21_backend_override(previous_); }
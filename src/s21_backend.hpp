@@ -0,0 +1,39 @@
+#ifndef S21_BACKEND_H_
+#define S21_BACKEND_H_
+
+#include <string>
+#include <vector>
+
+#include "s21_matrix/s21_matrix.h"
+
+#pragma once
+
+// Compute backends behind the heavy kernels of S21Matrix (GEMM, LU,
+// Cholesky, QR, transpose and element-wise ops). "builtin" is always there,
+// "blas" when the library was built against a system BLAS/LAPACK. Without
+// a selection the process uses $S21_BACKEND or the best backend that passes
+// the self-check against the built-in kernels.
+class S21Backend {
+ public:
+  static std::vector<std::string> Available();
+  static std::string Current();
+  // Process-wide selection; throws for an unknown backend or one whose
+  // results disagree with the built-in kernels.
+  static void Select(const std::string& name);
+  static bool SelfCheck(const std::string& name);
+};
+
+// Routes the kernels of the calling thread to another backend for the
+// lifetime of the scope, e.g. for a single call.
+class S21BackendScope {
+ private:
+  const s21_backend_t* previous_;
+
+ public:
+  explicit S21BackendScope(const std::string& name);
+  ~S21BackendScope();
+  S21BackendScope(const S21BackendScope&) = delete;
+  S21BackendScope& operator=(const S21BackendScope&) = delete;
+};
+
+#endif  // S21_BACKEND_H_
@@ -0,0 +1,128 @@
+#include "s21_hw_counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace {
+
+const char* const kCounterNames[kS21HwCounters] = {
+    "caller_cycles",     "caller_instructions", "caller_l1d_misses",
+    "caller_llc_misses", "caller_dtlb_misses"};
+
+#ifdef __linux__
+
+constexpr std::uint64_t CacheMiss(std::uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+const std::uint32_t kTypes[kS21HwCounters] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+    PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+
+const std::uint64_t kConfigs[kS21HwCounters] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    CacheMiss(PERF_COUNT_HW_CACHE_L1D), PERF_COUNT_HW_CACHE_MISSES,
+    CacheMiss(PERF_COUNT_HW_CACHE_DTLB)};
+
+// One group per thread, read with a single syscall. The first counter that
+// opens leads the group; members[i] is the position of counter i in the
+// read buffer or -1.
+struct Group {
+  int leader = -1;
+  int fds[kS21HwCounters];
+  int members[kS21HwCounters];
+  int size = 0;
+
+  Group() {
+    for (int i = 0; i < kS21HwCounters; i++) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = kTypes[i];
+      attr.config = kConfigs[i];
+      attr.disabled = leader < 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                         PERF_FORMAT_TOTAL_TIME_RUNNING;
+      fds[i] = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+      members[i] = fds[i] < 0 ? -1 : size++;
+      if (fds[i] >= 0 && leader < 0) leader = fds[i];
+    }
+    if (leader >= 0) ioctl(leader, PERF_EVENT_IOC_ENABLE, 0);
+  }
+
+  ~Group() {
+    for (int fd : fds) {
+      if (fd >= 0) close(fd);
+    }
+  }
+
+  Group(const Group&) = delete;
+  Group& operator=(const Group&) = delete;
+};
+
+Group& LocalGroup() {
+  thread_local Group group;
+  return group;
+}
+
+#endif
+
+}  // namespace
+
+const char* S21HwCounters::Name(S21HwCounter counter) {
+  return kCounterNames[static_cast<int>(counter)];
+}
+
+bool S21HwCounters::Available() {
+#ifdef __linux__
+  return LocalGroup().leader >= 0;
+#else
+  return false;
+#endif
+}
+
+bool S21HwCounters::Read(S21HwSample* sample) {
+#ifdef __linux__
+  Group& group = LocalGroup();
+  if (group.leader < 0) return false;
+  // nr, time enabled, time running, then one value per member.
+  std::uint64_t buffer[3 + kS21HwCounters];
+  ssize_t expected = sizeof(std::uint64_t) * (3 + group.size);
+  if (read(group.leader, buffer, sizeof(buffer)) != expected) return false;
+  sample->enabled = buffer[1];
+  sample->running = buffer[2];
+  sample->valid = 0;
+  for (int i = 0; i < kS21HwCounters; i++) {
+    int member = group.members[i];
+    sample->values[i] = member < 0 ? 0 : buffer[3 + member];
+    if (member >= 0) sample->valid |= 1u << i;
+  }
+  return true;
+#else
+  (void)sample;
+  return false;
+#endif
+}
+
+std::uint64_t S21HwCounters::Delta(const S21HwSample& before,
+                                   const S21HwSample& after,
+                                   S21HwCounter counter) {
+  int i = static_cast<int>(counter);
+  if (after.values[i] < before.values[i] || after.running <= before.running)
+    return 0;
+  double enabled = static_cast<double>(after.enabled - before.enabled);
+  double running = static_cast<double>(after.running - before.running);
+  return static_cast<std::uint64_t>(
+      static_cast<double>(after.values[i] - before.values[i]) * enabled /
+      running);
+}
@@ -0,0 +1,46 @@
+#ifndef S21_HW_COUNTERS_H_
+#define S21_HW_COUNTERS_H_
+
+#include <array>
+#include <cstdint>
+
+#pragma once
+
+enum class S21HwCounter {
+  kCycles,
+  kInstructions,
+  kL1dMisses,
+  kLlcMisses,
+  kDtlbMisses,
+  kCount
+};
+
+constexpr int kS21HwCounters = static_cast<int>(S21HwCounter::kCount);
+
+// Raw counter values of the calling thread, user mode only, with the times
+// the group was enabled and running. Bit i of valid is set when counter i
+// could be opened.
+struct S21HwSample {
+  std::array<std::uint64_t, kS21HwCounters> values{};
+  std::uint64_t enabled = 0, running = 0;
+  unsigned valid = 0;
+};
+
+// Hardware performance counters through Linux perf_event_open. Every thread
+// opens its own counter group on first use; where the kernel, the CPU or a
+// container policy refuses, Read returns false and nothing is counted.
+// Only the reading thread is counted, not the OpenMP workers of a kernel,
+// so the names carry a caller_ prefix.
+class S21HwCounters {
+ public:
+  static const char* Name(S21HwCounter counter);
+  // Whether at least one counter can be opened on the calling thread.
+  static bool Available();
+  static bool Read(S21HwSample* sample);
+  // Events of counter between two samples, the raw difference scaled by
+  // the share of that interval the group was multiplexed in.
+  static std::uint64_t Delta(const S21HwSample& before,
+                             const S21HwSample& after, S21HwCounter counter);
+};
+
+#endif  // S21_HW_COUNTERS_H_
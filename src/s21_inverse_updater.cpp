@@ -0,0 +1,135 @@
+#include "s21_inverse_updater.hpp"
+
+#include <cmath>
+
+S21InverseUpdater::S21InverseUpdater(const S21Matrix& matrix,
+                                     double drift_tolerance)
+    : S21InverseUpdater(matrix, matrix, 0.0, drift_tolerance) {
+  Refactorize();
+  refactorizations_ = 0;
+}
+
+S21InverseUpdater::S21InverseUpdater(const S21Matrix& matrix,
+                                     const S21Matrix& inverse,
+                                     double determinant,
+                                     double drift_tolerance)
+    : matrix_(matrix),
+      inverse_(inverse),
+      determinant_(determinant),
+      drift_tolerance_(drift_tolerance),
+      refactorizations_(0) {
+  int n = matrix.get_rows();
+  if (matrix.get_cols() != n)
+    throw std::runtime_error("The matrix is not square");
+  if (inverse.get_rows() != n || inverse.get_cols() != n)
+    throw std::runtime_error("Different matrix dimensions");
+  z_.resize(n);
+  w_.resize(n);
+  check_.resize(n);
+  probe_.resize(n);
+  for (int i = 0; i < n; i++) probe_[i] = (i % 3 == 0 ? 1.0 : -0.5) + 0.1 * i;
+}
+
+void S21InverseUpdater::RankOneUpdate(const std::vector<double>& u,
+                                      const std::vector<double>& v) {
+  std::size_t n = z_.size();
+  if (u.size() != n || v.size() != n)
+    throw std::runtime_error("Different matrix dimensions");
+  inverse_.Gemv(1.0, u, 0.0, z_);
+  inverse_.Gemv(1.0, v, 0.0, w_, true);
+  double denominator = 1.0;
+  for (std::size_t i = 0; i < n; i++) denominator += v[i] * z_[i];
+  if (denominator == 0) throw std::runtime_error("Matrix determinant is 0");
+  inverse_.Ger(-1.0 / denominator, z_, w_);
+  matrix_.Ger(1.0, u, v);
+  determinant_ *= denominator;
+  CheckDrift();
+}
+
+void S21InverseUpdater::RankUpdate(const S21Matrix& u, const S21Matrix& v) {
+  int n = matrix_.get_rows();
+  int k = u.get_cols();
+  if (u.get_rows() != n || v.get_rows() != n || v.get_cols() != k)
+    throw std::runtime_error("Different matrix dimensions");
+  S21Matrix z(n, k), w(k, n), capacitance(k, k);
+  z.Gemm(inverse_, u);
+  w.Gemm(v, inverse_, 1.0, 0.0, true);
+  for (int i = 0; i < k; i++) capacitance.matrix_->matrix[i][i] = 1.0;
+  capacitance.Gemm(v, z, 1.0, 1.0, true);
+  // (A + U V^T)^-1 = A^-1 - Z (I + V^T Z)^-1 V^T A^-1 with Z = A^-1 U.
+  S21Matrix lu(capacitance);
+  lu.Detach();
+  std::vector<int> pivots(k);
+  int sign = 1;
+  if (s21_lu_decomposition(lu.matrix_, pivots.data(), &sign) != 0)
+    throw std::runtime_error("Matrix determinant is 0");
+  double lemma = sign;
+  for (int i = 0; i < k; i++) lemma *= lu.matrix_->matrix[i][i];
+  s21_lu_solve(lu.matrix_, pivots.data(), w.matrix_);
+  inverse_.Gemm(z, w, -1.0, 1.0);
+  matrix_.Gemm(u, v, 1.0, 1.0, false, true);
+  determinant_ *= lemma;
+  CheckDrift();
+}
+
+void S21InverseUpdater::ReplaceRow(int row, const std::vector<double>& values) {
+  int n = matrix_.get_rows();
+  if (row < 0 || row >= n)
+    throw std::runtime_error("Index is outside the matrix");
+  if (values.size() != z_.size())
+    throw std::runtime_error("Different matrix dimensions");
+  std::vector<double> unit(n, 0.0), delta(values);
+  unit[row] = 1.0;
+  for (int j = 0; j < n; j++) delta[j] -= matrix_(row, j);
+  RankOneUpdate(unit, delta);
+}
+
+void S21InverseUpdater::ReplaceColumn(int col,
+                                      const std::vector<double>& values) {
+  int n = matrix_.get_rows();
+  if (col < 0 || col >= n)
+    throw std::runtime_error("Index is outside the matrix");
+  if (values.size() != z_.size())
+    throw std::runtime_error("Different matrix dimensions");
+  std::vector<double> unit(n, 0.0), delta(values);
+  unit[col] = 1.0;
+  for (int i = 0; i < n; i++) delta[i] -= matrix_(i, col);
+  RankOneUpdate(delta, unit);
+}
+
+void S21InverseUpdater::Refactorize() {
+  int n = matrix_.get_rows();
+  S21Matrix lu(matrix_);
+  lu.Detach();
+  std::vector<int> pivots(n);
+  int sign = 1;
+  if (s21_lu_decomposition(lu.matrix_, pivots.data(), &sign) != 0)
+    throw std::runtime_error("Matrix determinant is 0");
+  S21Matrix inverse(n, n);
+  for (int i = 0; i < n; i++) inverse.matrix_->matrix[i][i] = 1.0;
+  s21_lu_solve(lu.matrix_, pivots.data(), inverse.matrix_);
+  inverse_ = std::move(inverse);
+  determinant_ = sign;
+  for (int i = 0; i < n; i++) determinant_ *= lu.matrix_->matrix[i][i];
+  refactorizations_++;
+}
+
+void S21InverseUpdater::CheckDrift() {
+  if (drift_tolerance_ > 0) {
+    inverse_.Gemv(1.0, probe_, 0.0, z_);
+    matrix_.Gemv(1.0, z_, 0.0, check_);
+    double error = 0, norm = 0;
+    for (std::size_t i = 0; i < probe_.size(); i++) {
+      error = std::fmax(error, std::fabs(check_[i] - probe_[i]));
+      norm = std::fmax(norm, std::fabs(probe_[i]));
+    }
+    if (error > drift_tolerance_ * norm) Refactorize();
+  }
+}
+
+const S21Matrix& S21InverseUpdater::get_matrix() const { return matrix_; }
+const S21Matrix& S21InverseUpdater::get_inverse() const { return inverse_; }
+double S21InverseUpdater::get_determinant() const { return determinant_; }
+int S21InverseUpdater::get_refactorizations() const {
+  return refactorizations_;
+}
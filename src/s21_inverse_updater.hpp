@@ -0,0 +1,46 @@
+#ifndef S21_INVERSE_UPDATER_H_
+#define S21_INVERSE_UPDATER_H_
+
+#include "s21_matrix_oop.hpp"
+
+#pragma once
+
+// Keeps A, its inverse and determinant in sync under low-rank changes of A:
+// Sherman-Morrison for rank 1, Woodbury for rank k (O(n^2 k) each) and the
+// matrix determinant lemma for the determinant. With a positive drift
+// tolerance every update checks ||A * (A^-1 * x) - x|| on a fixed probe
+// vector and refactorizes from scratch once the error exceeds it.
+class S21InverseUpdater {
+ private:
+  S21Matrix matrix_;
+  S21Matrix inverse_;
+  double determinant_;
+  double drift_tolerance_;
+  int refactorizations_;
+  std::vector<double> z_, w_, probe_, check_;
+
+ public:
+  explicit S21InverseUpdater(const S21Matrix& matrix,
+                             double drift_tolerance = 0);
+  S21InverseUpdater(const S21Matrix& matrix, const S21Matrix& inverse,
+                    double determinant, double drift_tolerance = 0);
+
+  // A += u * v^T, u and v have n elements.
+  void RankOneUpdate(const std::vector<double>& u,
+                     const std::vector<double>& v);
+  // A += U * V^T, U and V are n x k.
+  void RankUpdate(const S21Matrix& u, const S21Matrix& v);
+  void ReplaceRow(int row, const std::vector<double>& values);
+  void ReplaceColumn(int col, const std::vector<double>& values);
+  void Refactorize();
+
+  const S21Matrix& get_matrix() const;
+  const S21Matrix& get_inverse() const;
+  double get_determinant() const;
+  int get_refactorizations() const;
+
+ private:
+  void CheckDrift();
+};
+
+#endif  // S21_INVERSE_UPDATER_H_
@@ -0,0 +1,97 @@
+#include "s21_maintained_product.hpp"
+
+S21MaintainedProduct::S21MaintainedProduct(const S21Matrix& a,
+                                           const S21Matrix& b)
+    : a_(a),
+      b_(b),
+      c_(a * b),
+      dirty_rows_(a.get_rows(), 0),
+      dirty_cols_(b.get_cols(), 0),
+      column_in_(b.get_rows()),
+      column_out_(a.get_rows()),
+      full_recomputations_(0) {}
+
+void S21MaintainedProduct::SetA(int row, int col, double value) {
+  a_(row, col) = value;
+  MarkRow(row);
+}
+
+void S21MaintainedProduct::SetRowA(int row, const std::vector<double>& values) {
+  if (values.size() != static_cast<std::size_t>(a_.get_cols()))
+    throw std::runtime_error("Different matrix dimensions");
+  for (int j = 0; j < a_.get_cols(); j++) a_(row, j) = values[j];
+  MarkRow(row);
+}
+
+void S21MaintainedProduct::SetB(int row, int col, double value) {
+  double& element = b_(row, col);
+  if (!dirty_cols_[col]) b_deltas_.push_back({row, col, value - element});
+  element = value;
+}
+
+void S21MaintainedProduct::SetColumnB(int col,
+                                      const std::vector<double>& values) {
+  if (values.size() != static_cast<std::size_t>(b_.get_rows()))
+    throw std::runtime_error("Different matrix dimensions");
+  for (int i = 0; i < b_.get_rows(); i++) b_(i, col) = values[i];
+  MarkColumn(col);
+}
+
+const S21Matrix& S21MaintainedProduct::Product() {
+  double m = a_.get_rows(), k = a_.get_cols(), n = b_.get_cols();
+  double cost = b_deltas_.size() * m + dirty_col_list_.size() * m * k +
+                dirty_row_list_.size() * k * n;
+  if (cost >= m * k * n) {
+    c_.Gemm(a_, b_);
+    full_recomputations_++;
+  } else {
+    c_.Detach();
+    matrix_t* a = a_.matrix_;
+    matrix_t* b = b_.matrix_;
+    matrix_t* c = c_.matrix_;
+    for (const Delta& delta : b_deltas_) {
+      if (dirty_cols_[delta.col]) continue;
+      for (int i = 0; i < c->rows; i++) {
+        c->matrix[i][delta.col] += a->matrix[i][delta.row] * delta.value;
+      }
+    }
+    for (int col : dirty_col_list_) {
+      for (int p = 0; p < b->rows; p++) column_in_[p] = b->matrix[p][col];
+      s21_gemv(0, 1.0, a, column_in_.data(), 0.0, column_out_.data());
+      for (int i = 0; i < c->rows; i++) c->matrix[i][col] = column_out_[i];
+    }
+    for (int row : dirty_row_list_) {
+      s21_gemv(1, 1.0, b, a->matrix[row], 0.0, c->matrix[row]);
+    }
+  }
+  Clear();
+  return c_;
+}
+
+const S21Matrix& S21MaintainedProduct::get_a() const { return a_; }
+const S21Matrix& S21MaintainedProduct::get_b() const { return b_; }
+int S21MaintainedProduct::get_full_recomputations() const {
+  return full_recomputations_;
+}
+
+void S21MaintainedProduct::MarkRow(int row) {
+  if (!dirty_rows_[row]) {
+    dirty_rows_[row] = 1;
+    dirty_row_list_.push_back(row);
+  }
+}
+
+void S21MaintainedProduct::MarkColumn(int col) {
+  if (!dirty_cols_[col]) {
+    dirty_cols_[col] = 1;
+    dirty_col_list_.push_back(col);
+  }
+}
+
+void S21MaintainedProduct::Clear() {
+  for (int row : dirty_row_list_) dirty_rows_[row] = 0;
+  for (int col : dirty_col_list_) dirty_cols_[col] = 0;
+  dirty_row_list_.clear();
+  dirty_col_list_.clear();
+  b_deltas_.clear();
+}
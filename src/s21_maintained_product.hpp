@@ -0,0 +1,46 @@
+#ifndef S21_MAINTAINED_PRODUCT_H_
+#define S21_MAINTAINED_PRODUCT_H_
+
+#include "s21_matrix_oop.hpp"
+
+#pragma once
+
+// Keeps C = A * B resident while A and B are edited through the setters
+// below. Edits are only recorded; Product() brings C up to date by
+// recomputing dirty rows of A (one GEMV each), dirty columns of B (one GEMV
+// each) and applying single-element changes of B as rank-1 corrections of
+// one column of C, falling back to a full product once that is cheaper.
+class S21MaintainedProduct {
+ private:
+  struct Delta {
+    int row, col;
+    double value;
+  };
+
+  S21Matrix a_, b_, c_;
+  std::vector<char> dirty_rows_, dirty_cols_;
+  std::vector<int> dirty_row_list_, dirty_col_list_;
+  std::vector<Delta> b_deltas_;
+  std::vector<double> column_in_, column_out_;
+  int full_recomputations_;
+
+ public:
+  S21MaintainedProduct(const S21Matrix& a, const S21Matrix& b);
+
+  void SetA(int row, int col, double value);
+  void SetRowA(int row, const std::vector<double>& values);
+  void SetB(int row, int col, double value);
+  void SetColumnB(int col, const std::vector<double>& values);
+
+  const S21Matrix& Product();
+  const S21Matrix& get_a() const;
+  const S21Matrix& get_b() const;
+  int get_full_recomputations() const;
+
+ private:
+  void MarkRow(int row);
+  void MarkColumn(int col);
+  void Clear();
+};
+
+#endif  // S21_MAINTAINED_PRODUCT_H_
@@ -0,0 +1,29 @@
+#include "s21_matrix.h"
+
+// Y = alpha * X + beta * Y, the beta == 0 case ignores the old contents of Y.
+int s21_axpby_matrix(double alpha, matrix_t *X, double beta, matrix_t *Y) {
+  int flag = OK;
+  if (X->columns <= 0 || X->rows <= 0 || Y->columns <= 0 || Y->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (X->rows != Y->rows || X->columns != Y->columns) {
+    flag = CALC_ERROR;
+  } else {
+    int parallel = (long)X->rows * X->columns >=
+                   s21_tuning_current()->elementwise_threshold;
+#pragma omp parallel for if (parallel) schedule(static)
+    for (int row = 0; row < X->rows; row++) {
+      const double *x_row = X->matrix[row];
+      double *y_row = Y->matrix[row];
+      if (beta == 0.0) {
+#pragma omp simd
+        for (int j = 0; j < X->columns; j++) y_row[j] = alpha * x_row[j];
+      } else {
+#pragma omp simd
+        for (int j = 0; j < X->columns; j++) {
+          y_row[j] = alpha * x_row[j] + beta * y_row[j];
+        }
+      }
+    }
+  }
+  return flag;
+}
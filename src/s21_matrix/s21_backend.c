@@ -0,0 +1,169 @@
+#include "s21_matrix.h"
+
+static const s21_backend_t s21_builtin = {
+    "builtin",            s21_gemm,      s21_lu_decomposition, s21_cholesky,
+    s21_qr_decomposition, s21_transpose, s21_axpby_matrix};
+
+static const s21_backend_t *s21_process_backend = NULL;
+static _Thread_local const s21_backend_t *s21_thread_backend = NULL;
+
+const s21_backend_t *s21_backend_builtin(void) { return &s21_builtin; }
+
+// Backends compiled into this build, the built-in one first.
+int s21_backend_count(void) { return s21_backend_blas() != NULL ? 2 : 1; }
+
+const s21_backend_t *s21_backend_at(int index) {
+  const s21_backend_t *backend = NULL;
+  if (index == 0) {
+    backend = &s21_builtin;
+  } else if (index == 1) {
+    backend = s21_backend_blas();
+  }
+  return backend;
+}
+
+const s21_backend_t *s21_backend_find(const char *name) {
+  const s21_backend_t *found = NULL;
+  for (int i = 0; name != NULL && found == NULL && i < s21_backend_count();
+       i++) {
+    if (strcmp(s21_backend_at(i)->name, name) == 0) found = s21_backend_at(i);
+  }
+  return found;
+}
+
+// Fills A with the deterministic values used by the self-check.
+static void s21_check_fill(matrix_t *A, unsigned seed) {
+  for (int i = 0; i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      seed = seed * 1103515245u + 12345u;
+      A->matrix[i][j] = (double)((seed >> 8) % 4001u) / 1000.0 - 2.0;
+    }
+  }
+}
+
+static double s21_check_difference(matrix_t *A, matrix_t *B) {
+  double difference = 0, scale = 1;
+  for (int i = 0; i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      difference = fmax(difference, fabs(A->matrix[i][j] - B->matrix[i][j]));
+      scale = fmax(scale, fabs(A->matrix[i][j]));
+    }
+  }
+  return difference / scale;
+}
+
+// Runs one kernel of both backends on copies of the same input.
+// kernel: 0 gemm, 1 lu, 2 cholesky, 3 qr, 4 transpose, 5 axpby.
+static int s21_check_kernel(const s21_backend_t *backend,
+                            const s21_backend_t *reference, int kernel) {
+  int rows = 23, columns = kernel == 3 ? 13 : 23;
+  matrix_t A[2] = {{0}}, B[2] = {{0}}, C[2] = {{0}};
+  int pivots[2][23] = {{0}}, sign[2] = {0}, status[2] = {0};
+  double tau[2][23] = {{0}};
+  for (int k = 0; k < 2; k++) {
+    const s21_backend_t *current = k == 0 ? backend : reference;
+    s21_create_matrix(rows, columns, &A[k]);
+    s21_create_matrix(rows, columns, &B[k]);
+    s21_create_matrix(rows, columns, &C[k]);
+    s21_check_fill(&A[k], 7u);
+    s21_check_fill(&B[k], 11u);
+    s21_check_fill(&C[k], 13u);
+    if (kernel == 0) {
+      status[k] = current->gemm(0, 1, 1.5, &A[k], &B[k], -0.5, &C[k]);
+    } else if (kernel == 1) {
+      status[k] = current->lu_decomposition(&A[k], pivots[k], &sign[k]);
+    } else if (kernel == 2) {
+      s21_gemm(0, 1, 1.0, &B[k], &B[k], 0.0, &A[k]);
+      for (int i = 0; i < rows; i++) A[k].matrix[i][i] += rows;
+      status[k] = current->cholesky(&A[k]);
+    } else if (kernel == 3) {
+      status[k] = current->qr_decomposition(&A[k], tau[k]);
+    } else if (kernel == 4) {
+      status[k] = current->transpose(&A[k], &C[k]);
+    } else {
+      status[k] = current->axpby(-2.0, &A[k], 0.25, &C[k]);
+    }
+  }
+  double difference = fmax(s21_check_difference(&A[0], &A[1]),
+                           s21_check_difference(&C[0], &C[1]));
+  for (int i = 0; i < rows; i++) {
+    if (pivots[0][i] != pivots[1][i]) difference = 1;
+    difference = fmax(difference, fabs(tau[0][i] - tau[1][i]));
+  }
+  for (int k = 0; k < 2; k++) {
+    s21_remove_matrix(&A[k]);
+    s21_remove_matrix(&B[k]);
+    s21_remove_matrix(&C[k]);
+  }
+  int same = status[0] == status[1] && sign[0] == sign[1];
+  return same && difference <= 1e-10 ? OK : CALC_ERROR;
+}
+
+// Compares every kernel of backend with the same kernel of reference on
+// small fixed problems. Returns OK when all results agree.
+int s21_backend_self_check(const s21_backend_t *backend,
+                           const s21_backend_t *reference) {
+  int flag = backend == NULL || reference == NULL ? INCORRECT_MATRIX : OK;
+  for (int kernel = 0; flag == OK && kernel < 6; kernel++) {
+    flag = s21_check_kernel(backend, reference, kernel);
+  }
+  return flag;
+}
+
+// The process-wide backend is chosen on first use: the one named by the
+// S21_BACKEND environment variable, otherwise the last one compiled in.
+// Anything other than the built-in backend must pass the self-check.
+static void s21_backend_startup(void) {
+  const s21_backend_t *chosen = s21_backend_find(getenv("S21_BACKEND"));
+  if (chosen == NULL) chosen = s21_backend_at(s21_backend_count() - 1);
+  if (chosen != &s21_builtin &&
+      s21_backend_self_check(chosen, &s21_builtin) != OK) {
+    chosen = &s21_builtin;
+  }
+#pragma omp atomic write
+  s21_process_backend = chosen;
+}
+
+// Sets the backend for the whole process after a self-check against the
+// built-in kernels; the previous backend stays if the check fails.
+int s21_backend_select(const s21_backend_t *backend) {
+  int flag = s21_backend_self_check(backend, &s21_builtin);
+  if (flag == OK) {
+#pragma omp atomic write
+    s21_process_backend = backend;
+  }
+  return flag;
+}
+
+// Overrides the backend on the calling thread only, NULL restores the
+// process-wide one. Returns the previous override.
+const s21_backend_t *s21_backend_override(const s21_backend_t *backend) {
+  const s21_backend_t *previous = s21_thread_backend;
+  s21_thread_backend = backend;
+  return previous;
+}
+
+const s21_backend_t *s21_backend_current(void) {
+  const s21_backend_t *current = s21_thread_backend;
+  if (current == NULL) {
+#pragma omp atomic read
+    current = s21_process_backend;
+  }
+  if (current == NULL) {
+#pragma omp critical(s21_backend)
+    if (s21_process_backend == NULL) s21_backend_startup();
+#pragma omp atomic read
+    current = s21_process_backend;
+  }
+  return current;
+}
+
+// Distance between consecutive rows when they are equally spaced, which is
+// the case for every matrix and view created by this library; 0 otherwise.
+int s21_leading_dimension(matrix_t *A) {
+  long stride = A->rows > 1 ? A->matrix[1] - A->matrix[0] : A->columns;
+  for (int i = 2; i < A->rows && stride != 0; i++) {
+    if (A->matrix[i] - A->matrix[i - 1] != stride) stride = 0;
+  }
+  return stride >= A->columns ? (int)stride : 0;
+}
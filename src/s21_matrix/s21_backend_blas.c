@@ -0,0 +1,167 @@
+#include "s21_matrix.h"
+
+#ifdef S21_WITH_BLAS
+#include <cblas.h>
+
+// Fortran LAPACK entry points; the trailing length is the hidden argument
+// gfortran passes for character parameters.
+void dgetrf_(const int *m, const int *n, double *a, const int *lda,
+             int *ipiv, int *info);
+void dgeqrf_(const int *m, const int *n, double *a, const int *lda,
+             double *tau, double *work, const int *lwork, int *info);
+void dpotrf_(const char *uplo, const int *n, double *a, const int *lda,
+             int *info, size_t uplo_length);
+
+static int s21_blas_gemm(int trans_a, int trans_b, double alpha, matrix_t *A,
+                         matrix_t *B, double beta, matrix_t *C) {
+  int lda = s21_leading_dimension(A), ldb = s21_leading_dimension(B),
+      ldc = s21_leading_dimension(C);
+  int m = trans_a ? A->columns : A->rows, k = trans_a ? A->rows : A->columns;
+  int k_b = trans_b ? B->columns : B->rows, n = trans_b ? B->rows : B->columns;
+  int flag = OK;
+  if (lda == 0 || ldb == 0 || ldc == 0 || A->rows <= 0 || A->columns <= 0 ||
+      B->rows <= 0 || B->columns <= 0) {
+    flag = s21_gemm(trans_a, trans_b, alpha, A, B, beta, C);
+  } else if (k != k_b || C->rows != m || C->columns != n) {
+    flag = CALC_ERROR;
+  } else {
+    cblas_dgemm(CblasRowMajor, trans_a ? CblasTrans : CblasNoTrans,
+                trans_b ? CblasTrans : CblasNoTrans, m, n, k, alpha,
+                A->matrix[0], lda, B->matrix[0], ldb, beta, C->matrix[0], ldc);
+  }
+  return flag;
+}
+
+// LAPACK works on columns: A is copied into a column-major buffer and back.
+// NULL when the copy does not fit the memory budget; the callers then run
+// the built-in kernel in place.
+static double *s21_column_major(matrix_t *A) {
+  double *buffer =
+      s21_memory_alloc(sizeof(double) * A->rows * (size_t)A->columns, 0);
+  for (int i = 0; buffer != NULL && i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      buffer[i + (size_t)j * A->rows] = A->matrix[i][j];
+    }
+  }
+  return buffer;
+}
+
+static void s21_row_major(const double *buffer, matrix_t *A) {
+  for (int i = 0; i < A->rows; i++) {
+    for (int j = 0; j < A->columns; j++) {
+      A->matrix[i][j] = buffer[i + (size_t)j * A->rows];
+    }
+  }
+}
+
+static int s21_blas_lu_decomposition(matrix_t *A, int *pivots, int *sign) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->columns != A->rows) {
+    flag = CALC_ERROR;
+  } else {
+    int n = A->rows, info = 0;
+    double *buffer = s21_column_major(A);
+    if (buffer == NULL) {
+      flag = s21_lu_decomposition(A, pivots, sign);
+    } else {
+      dgetrf_(&n, &n, buffer, &n, pivots, &info);
+      s21_row_major(buffer, A);
+      s21_memory_free(buffer, sizeof(double) * n * (size_t)n);
+      *sign = 1;
+      for (int k = 0; k < n; k++) {
+        pivots[k]--;
+        if (pivots[k] != k) *sign = -*sign;
+      }
+      if (info != 0) flag = CALC_ERROR;
+    }
+  }
+  return flag;
+}
+
+// A symmetric row-major matrix read as column-major is its own transpose, so
+// the upper factor of LAPACK lands in the lower triangle without a copy.
+static int s21_blas_cholesky(matrix_t *A) {
+  int lda = s21_leading_dimension(A), flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->columns != A->rows) {
+    flag = CALC_ERROR;
+  } else if (lda == 0) {
+    flag = s21_cholesky(A);
+  } else {
+    int n = A->rows, info = 0;
+    dpotrf_("U", &n, A->matrix[0], &lda, &info, 1);
+    if (info != 0) flag = CALC_ERROR;
+    for (int i = 0; i < n && flag == OK; i++) {
+      for (int j = i + 1; j < n; j++) A->matrix[i][j] = 0;
+    }
+  }
+  return flag;
+}
+
+static int s21_blas_qr_decomposition(matrix_t *A, double *tau) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    int m = A->rows, n = A->columns, info = 0, query = -1;
+    double size = 0;
+    dgeqrf_(&m, &n, NULL, &m, tau, &size, &query, &info);
+    int lwork = size > 1 ? (int)size : 1;
+    size_t work_bytes = sizeof(double) * lwork;
+    double *work = info == 0 ? s21_memory_alloc(work_bytes, 0) : NULL;
+    double *buffer = work != NULL ? s21_column_major(A) : NULL;
+    if (info != 0) {
+      flag = CALC_ERROR;
+    } else if (work == NULL || buffer == NULL) {
+      flag = s21_qr_decomposition(A, tau);
+    } else {
+      dgeqrf_(&m, &n, buffer, &m, tau, work, &lwork, &info);
+      if (info != 0) {
+        flag = CALC_ERROR;
+      } else {
+        s21_row_major(buffer, A);
+      }
+    }
+    if (buffer != NULL) s21_memory_free(buffer, sizeof(double) * m * (size_t)n);
+    if (work != NULL) s21_memory_free(work, work_bytes);
+  }
+  return flag;
+}
+
+static int s21_blas_axpby(double alpha, matrix_t *X, double beta, matrix_t *Y) {
+  int flag = OK;
+  if (X->columns <= 0 || X->rows <= 0 || Y->columns <= 0 || Y->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (X->rows != Y->rows || X->columns != Y->columns) {
+    flag = CALC_ERROR;
+  } else {
+    for (int row = 0; row < X->rows; row++) {
+      if (beta == 0.0) {
+        if (X != Y) {
+          cblas_dcopy(X->columns, X->matrix[row], 1, Y->matrix[row], 1);
+        }
+        cblas_dscal(X->columns, alpha, Y->matrix[row], 1);
+      } else if (X == Y) {
+        cblas_dscal(X->columns, alpha + beta, Y->matrix[row], 1);
+      } else {
+        cblas_dscal(X->columns, beta, Y->matrix[row], 1);
+        cblas_daxpy(X->columns, alpha, X->matrix[row], 1, Y->matrix[row], 1);
+      }
+    }
+  }
+  return flag;
+}
+
+// The transpose is pure data movement, the built-in kernel is kept.
+static const s21_backend_t s21_blas = {
+    "blas",            s21_blas_gemm,             s21_blas_lu_decomposition,
+    s21_blas_cholesky, s21_blas_qr_decomposition, s21_transpose,
+    s21_blas_axpby};
+
+const s21_backend_t *s21_backend_blas(void) { return &s21_blas; }
+#else
+const s21_backend_t *s21_backend_blas(void) { return NULL; }
+#endif
@@ -0,0 +1,106 @@
+#include "s21_matrix.h"
+
+// Working storage of a banded LU: every row keeps columns
+// [row - lower, row + lower + upper], the extra `lower` diagonals hold the
+// fill-in caused by partial pivoting.
+static double *s21_band_at(packed_t *A, double *work, int row, int column) {
+  size_t width = 2 * A->lower + A->upper + 1;
+  return work + (size_t)row * width + column - row + A->lower;
+}
+
+// Returns NULL when the working storage cannot be allocated. Release with
+// s21_band_lu_remove.
+double *s21_band_lu_create(packed_t *A) {
+  size_t width = 2 * A->lower + A->upper + 1;
+  double *work = s21_memory_alloc(sizeof(double) * A->size * width, 1);
+  if (work != NULL) {
+    for (int row = 0; row < A->size; row++) {
+      int first = 0, last = 0;
+      s21_packed_range(A, row, &first, &last);
+      for (int column = first; column <= last; column++) {
+        *s21_band_at(A, work, row, column) = *s21_packed_at(A, row, column);
+      }
+    }
+  }
+  return work;
+}
+
+void s21_band_lu_remove(packed_t *A, double *work) {
+  size_t width = 2 * A->lower + A->upper + 1;
+  s21_memory_free(work, sizeof(double) * A->size * width);
+}
+
+// Gaussian elimination with partial pivoting restricted to the band, O(n * l *
+// (l + u)). Returns CALC_ERROR for a singular matrix.
+int s21_band_lu_decomposition(packed_t *A, double *work, int *pivots,
+                              int *sign) {
+  int flag = OK;
+  int n = A->size;
+  *sign = 1;
+  for (int k = 0; k < n && flag == OK; k++) {
+    int last_row = k + A->lower < n - 1 ? k + A->lower : n - 1;
+    int last_column =
+        k + A->lower + A->upper < n - 1 ? k + A->lower + A->upper : n - 1;
+    int pivot = k;
+    for (int i = k + 1; i <= last_row; i++) {
+      if (fabs(*s21_band_at(A, work, i, k)) >
+          fabs(*s21_band_at(A, work, pivot, k))) {
+        pivot = i;
+      }
+    }
+    pivots[k] = pivot;
+    if (*s21_band_at(A, work, pivot, k) == 0) {
+      flag = CALC_ERROR;
+    } else {
+      if (pivot != k) {
+        *sign = -*sign;
+        for (int j = k; j <= last_column; j++) {
+          double value = *s21_band_at(A, work, k, j);
+          *s21_band_at(A, work, k, j) = *s21_band_at(A, work, pivot, j);
+          *s21_band_at(A, work, pivot, j) = value;
+        }
+      }
+      double diagonal = *s21_band_at(A, work, k, k);
+      for (int i = k + 1; i <= last_row; i++) {
+        double factor = *s21_band_at(A, work, i, k) / diagonal;
+        *s21_band_at(A, work, i, k) = factor;
+        for (int j = k + 1; j <= last_column; j++) {
+          *s21_band_at(A, work, i, j) -= factor * *s21_band_at(A, work, k, j);
+        }
+      }
+    }
+  }
+  return flag;
+}
+
+double s21_band_lu_diagonal(packed_t *A, double *work, int row) {
+  return *s21_band_at(A, work, row, row);
+}
+
+// Solves A * X = B in place of B with the factors of s21_band_lu_decomposition.
+void s21_band_lu_solve(packed_t *A, double *work, const int *pivots,
+                       matrix_t *B) {
+  int n = A->size;
+  for (int k = 0; k < n; k++) {
+    if (pivots[k] != k) s21_swap_rows(B, k, pivots[k]);
+    int last_row = k + A->lower < n - 1 ? k + A->lower : n - 1;
+    for (int i = k + 1; i <= last_row; i++) {
+      double factor = *s21_band_at(A, work, i, k);
+      for (int j = 0; j < B->columns; j++) {
+        B->matrix[i][j] -= factor * B->matrix[k][j];
+      }
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    int last_column =
+        i + A->lower + A->upper < n - 1 ? i + A->lower + A->upper : n - 1;
+    for (int k = i + 1; k <= last_column; k++) {
+      double factor = *s21_band_at(A, work, i, k);
+      for (int j = 0; j < B->columns; j++) {
+        B->matrix[i][j] -= factor * B->matrix[k][j];
+      }
+    }
+    double diagonal = *s21_band_at(A, work, i, i);
+    for (int j = 0; j < B->columns; j++) B->matrix[i][j] /= diagonal;
+  }
+}
@@ -0,0 +1,62 @@
+#include "s21_matrix.h"
+
+// Collects the Householder vectors stored below the diagonal of QR in columns
+// [column, column + block) into an explicit unit lower trapezoidal V and
+// builds the upper triangular T so that H_1 * ... * H_b = I - V * T * V^T.
+int s21_block_reflector_build(matrix_t *QR, const double *tau, int column,
+                              int block, matrix_t *V, matrix_t *T) {
+  int flag = OK;
+  if (QR->rows <= 0 || QR->columns <= 0 || block <= 0 || column < 0 ||
+      column + block > QR->columns || column + block > QR->rows) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    int rows = QR->rows - column;
+    if (s21_create_matrix(rows, block, V) != OK ||
+        s21_create_matrix(block, block, T) != OK) {
+      s21_remove_matrix(V);
+      flag = MEMORY_ERROR;
+    }
+    for (int j = 0; j < block && flag == OK; j++) {
+      V->matrix[j][j] = 1.0;
+      for (int i = j + 1; i < rows; i++) {
+        V->matrix[i][j] = QR->matrix[column + i][column + j];
+      }
+    }
+    for (int j = 0; j < block && flag == OK; j++) {
+      T->matrix[j][j] = tau[column + j];
+      for (int r = 0; r < j; r++) {
+        double dot = 0;
+        for (int i = j; i < rows; i++) dot += V->matrix[i][r] * V->matrix[i][j];
+        T->matrix[r][j] = dot;
+      }
+      for (int r = 0; r < j; r++) {
+        double sum = 0;
+        for (int c = r; c < j; c++) sum += T->matrix[r][c] * T->matrix[c][j];
+        T->matrix[r][j] = -tau[column + j] * sum;
+      }
+    }
+  }
+  return flag;
+}
+
+// C = (I - V * op(T) * V^T) * C, where op(T) is T^T when transpose is set.
+// Runs as three GEMM calls.
+int s21_block_reflector_apply(matrix_t *V, matrix_t *T, int transpose,
+                              matrix_t *C) {
+  int flag = OK;
+  if (V->rows != C->rows || V->columns != T->rows) {
+    flag = CALC_ERROR;
+  } else {
+    matrix_t W = {0}, TW = {0};
+    if (s21_create_matrix(V->columns, C->columns, &W) != OK ||
+        s21_create_matrix(V->columns, C->columns, &TW) != OK) {
+      flag = MEMORY_ERROR;
+    }
+    if (flag == OK) flag = s21_gemm(1, 0, 1.0, V, C, 0.0, &W);
+    if (flag == OK) flag = s21_gemm(transpose, 0, 1.0, T, &W, 0.0, &TW);
+    if (flag == OK) flag = s21_gemm(0, 0, -1.0, V, &TW, 1.0, C);
+    s21_remove_matrix(&W);
+    s21_remove_matrix(&TW);
+  }
+  return flag;
+}
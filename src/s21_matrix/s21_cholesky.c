@@ -0,0 +1,41 @@
+#include "s21_matrix.h"
+
+// In-place Cholesky factorization A = L * L^T of a symmetric positive
+// definite A; only the lower triangle is read, L replaces it and the strict
+// upper triangle is zeroed. Returns CALC_ERROR if A is not positive definite.
+int s21_cholesky(matrix_t *A) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->columns != A->rows) {
+    flag = CALC_ERROR;
+  } else {
+    int n = A->rows;
+    S21_TRACE("cholesky.factor", 1, n, n);
+    for (int j = 0; j < n && flag == OK; j++) {
+      double *row_j = A->matrix[j];
+      double diagonal = row_j[j];
+      for (int k = 0; k < j; k++) diagonal -= row_j[k] * row_j[k];
+      if (!(diagonal > 0)) {
+        flag = CALC_ERROR;
+      } else {
+        row_j[j] = sqrt(diagonal);
+        int parallel =
+            (long)(n - j) * j >= s21_tuning_current()->parallel_threshold;
+#pragma omp parallel for if (parallel) schedule(static)
+        for (int i = j + 1; i < n; i++) {
+          double *row_i = A->matrix[i];
+          double sum = row_i[j];
+#pragma omp simd reduction(- : sum)
+          for (int k = 0; k < j; k++) sum -= row_i[k] * row_j[k];
+          row_i[j] = sum / row_j[j];
+        }
+      }
+    }
+    for (int i = 0; i < n && flag == OK; i++) {
+      for (int j = i + 1; j < n; j++) A->matrix[i][j] = 0;
+    }
+    S21_TRACE("cholesky.factor", 0, n, n);
+  }
+  return flag;
+}
@@ -1,16 +1,35 @@
 #include "s21_matrix.h"
 
+// Allocates a zeroed rows x columns matrix in one block. Returns
+// MEMORY_ERROR, with result left empty, if the size overflows, the memory
+// budget would be exceeded or the system is out of memory.
 int s21_create_matrix(int rows, int columns, matrix_t *result) {
   int flag = OK;
   if (rows > 0 && columns > 0) {
-    result->rows = rows;
-    result->columns = columns;
-    result->matrix = calloc(rows, sizeof(double));
-    for (int i = 0; i < rows; i++) {
-      result->matrix[i] = calloc(columns, sizeof(double));
+    result->rows = 0;
+    result->columns = 0;
+    result->matrix = NULL;
+    double **pointers = NULL;
+    double *elements = NULL;
+    if ((size_t)columns <= SIZE_MAX / sizeof(double) / (size_t)rows) {
+      pointers = s21_memory_alloc(sizeof(double *) * rows, 0);
+    }
+    if (pointers != NULL) {
+      elements = s21_memory_alloc(sizeof(double) * rows * (size_t)columns, 1);
+    }
+    if (elements == NULL) {
+      s21_memory_free(pointers, sizeof(double *) * rows);
+      flag = MEMORY_ERROR;
+    } else {
+      result->rows = rows;
+      result->columns = columns;
+      result->matrix = pointers;
+      for (int i = 0; i < rows; i++) {
+        pointers[i] = elements + (size_t)i * columns;
+      }
     }
   } else {
     flag = INCORRECT_MATRIX;
   }
   return flag;
-}
\ No newline at end of file
+}
@@ -0,0 +1,121 @@
+#include "s21_matrix.h"
+
+size_t s21_packed_elements(int size, int kind, int lower, int upper) {
+  size_t n = size;
+  size_t elements = 0;
+  if (kind == S21_DIAGONAL) {
+    elements = n;
+  } else if (kind == S21_BANDED) {
+    elements = n * (size_t)(lower + upper + 1);
+  } else {
+    elements = n * (n + 1) / 2;
+  }
+  return elements;
+}
+
+int s21_create_packed(int size, int kind, int lower, int upper,
+                      packed_t *result) {
+  int flag = OK;
+  if (size <= 0 || kind < S21_SYMMETRIC || kind > S21_BANDED ||
+      (kind == S21_BANDED && (lower < 0 || upper < 0 || lower >= size ||
+                              upper >= size))) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    result->size = size;
+    result->kind = kind;
+    result->lower = kind == S21_BANDED ? lower : 0;
+    result->upper = kind == S21_BANDED ? upper : 0;
+    size_t elements = s21_packed_elements(size, kind, lower, upper);
+    result->data = elements <= SIZE_MAX / sizeof(double)
+                       ? s21_memory_alloc(sizeof(double) * elements, 1)
+                       : NULL;
+    if (result->data == NULL) {
+      result->size = 0;
+      flag = MEMORY_ERROR;
+    }
+  }
+  return flag;
+}
+
+void s21_remove_packed(packed_t *A) {
+  if (A->size > 0) {
+    s21_memory_free(A->data, sizeof(double) * s21_packed_elements(
+                                                  A->size, A->kind, A->lower,
+                                                  A->upper));
+  }
+  A->data = NULL;
+  A->size = 0;
+}
+
+// Columns of `row` that are actually stored. Symmetric matrices keep the lower
+// triangle.
+void s21_packed_range(packed_t *A, int row, int *first, int *last) {
+  if (A->kind == S21_SYMMETRIC || A->kind == S21_LOWER_TRIANGULAR) {
+    *first = 0;
+    *last = row;
+  } else if (A->kind == S21_UPPER_TRIANGULAR) {
+    *first = row;
+    *last = A->size - 1;
+  } else if (A->kind == S21_DIAGONAL) {
+    *first = row;
+    *last = row;
+  } else {
+    *first = row - A->lower > 0 ? row - A->lower : 0;
+    *last = row + A->upper < A->size - 1 ? row + A->upper : A->size - 1;
+  }
+}
+
+// Address of element (row, column) in the packed storage or NULL when the
+// structure forces it to zero.
+double *s21_packed_at(packed_t *A, int row, int column) {
+  double *element = NULL;
+  if (A->kind == S21_SYMMETRIC && column > row) {
+    int swap = row;
+    row = column;
+    column = swap;
+  }
+  int first = 0, last = 0;
+  s21_packed_range(A, row, &first, &last);
+  if (column >= first && column <= last) {
+    size_t i = row, n = A->size;
+    if (A->kind == S21_SYMMETRIC || A->kind == S21_LOWER_TRIANGULAR) {
+      element = A->data + i * (i + 1) / 2 + column;
+    } else if (A->kind == S21_UPPER_TRIANGULAR) {
+      element = A->data + i * n - i * (i - 1) / 2 + (column - row);
+    } else if (A->kind == S21_DIAGONAL) {
+      element = A->data + i;
+    } else {
+      element = A->data + i * (A->lower + A->upper + 1) + column - row +
+                A->lower;
+    }
+  }
+  return element;
+}
+
+double s21_packed_get(packed_t *A, int row, int column) {
+  double *element = s21_packed_at(A, row, column);
+  return element ? *element : 0.0;
+}
+
+// Row pointers over the lower triangle of a symmetric or lower triangular A,
+// so that kernels writing only columns j <= i of every row can fill the
+// packed storage directly. Release with s21_remove_submatrix. Returns
+// MEMORY_ERROR when the row pointers cannot be allocated.
+int s21_packed_rows(packed_t *A, matrix_t *rows) {
+  int flag = OK;
+  if (A->kind != S21_SYMMETRIC && A->kind != S21_LOWER_TRIANGULAR) {
+    flag = CALC_ERROR;
+  } else {
+    rows->matrix = s21_memory_alloc(sizeof(double *) * A->size, 0);
+    if (rows->matrix == NULL) {
+      flag = MEMORY_ERROR;
+    } else {
+      rows->rows = A->size;
+      rows->columns = A->size;
+      for (size_t i = 0; i < (size_t)A->size; i++) {
+        rows->matrix[i] = A->data + i * (i + 1) / 2;
+      }
+    }
+  }
+  return flag;
+}
@@ -0,0 +1,105 @@
+#include <omp.h>
+
+#include "s21_matrix.h"
+
+static double s21_op_element(matrix_t *A, int trans, int row, int column) {
+  return trans ? A->matrix[column][row] : A->matrix[row][column];
+}
+
+// C = alpha * op(A) * op(B) + beta * C in a single pass over C, which must be
+// allocated beforehand and must not share storage with A or B. op(X) is X or
+// X^T depending on trans. Row blocks of C are split across OpenMP threads.
+// Near the memory budget the packing tiles shrink until their scratch fits;
+// MEMORY_ERROR is returned only if even the smallest do not.
+int s21_gemm(int trans_a, int trans_b, double alpha, matrix_t *A, matrix_t *B,
+             double beta, matrix_t *C) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0 || B->columns <= 0 || B->rows <= 0 ||
+      C->columns <= 0 || C->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    int m = trans_a ? A->columns : A->rows;
+    int k = trans_a ? A->rows : A->columns;
+    int k_b = trans_b ? B->columns : B->rows;
+    int n = trans_b ? B->rows : B->columns;
+    if (k != k_b || C->rows != m || C->columns != n) {
+      flag = CALC_ERROR;
+    } else {
+      const s21_tuning_t *tuning = s21_tuning_current();
+      int tile_m = tuning->gemm_mc, tile_k = tuning->gemm_kc,
+          tile_n = tuning->gemm_nc;
+      int parallel = (double)m * n * k >= tuning->parallel_threshold;
+      int threads = parallel ? omp_get_max_threads() : 1;
+      while ((tile_m > 8 || tile_k > 8 || tile_n > 8) &&
+             !s21_memory_fits(sizeof(double) * (double)tile_k *
+                              (tile_n + (double)threads * tile_m))) {
+        tile_m = tile_m > 8 ? tile_m / 2 : tile_m;
+        tile_k = tile_k > 8 ? tile_k / 2 : tile_k;
+        tile_n = tile_n > 8 ? tile_n / 2 : tile_n;
+      }
+      size_t b_bytes = sizeof(double) * tile_k * tile_n;
+      size_t a_bytes = sizeof(double) * tile_m * tile_k * threads;
+      double *b_pack = s21_memory_alloc(b_bytes, 0);
+      double *a_packs = b_pack ? s21_memory_alloc(a_bytes, 0) : NULL;
+      if (a_packs == NULL) {
+        flag = MEMORY_ERROR;
+      } else {
+#pragma omp parallel if (parallel) num_threads(threads)
+        {
+          double *a_pack =
+              a_packs + (size_t)omp_get_thread_num() * tile_m * tile_k;
+          if (beta != 1.0) {
+#pragma omp for schedule(static)
+            for (int i = 0; i < m; i++) {
+              double *c_row = C->matrix[i];
+              for (int j = 0; j < n; j++) {
+                c_row[j] = beta == 0.0 ? 0.0 : c_row[j] * beta;
+              }
+            }
+          }
+          for (int jc = 0; jc < n && alpha != 0.0; jc += tile_n) {
+            int nc = n - jc < tile_n ? n - jc : tile_n;
+            for (int pc = 0; pc < k; pc += tile_k) {
+              int kc = k - pc < tile_k ? k - pc : tile_k;
+              S21_TRACE("gemm.pack_b", 1, kc, nc);
+#pragma omp for schedule(static)
+              for (int p = 0; p < kc; p++) {
+                for (int j = 0; j < nc; j++) {
+                  b_pack[p * nc + j] =
+                      s21_op_element(B, trans_b, pc + p, jc + j);
+                }
+              }
+              S21_TRACE("gemm.pack_b", 0, kc, nc);
+              int blocks = (m + tile_m - 1) / tile_m;
+#pragma omp for schedule(dynamic)
+              for (int block = 0; block < blocks; block++) {
+                int ic = block * tile_m;
+                int mc = m - ic < tile_m ? m - ic : tile_m;
+                S21_TRACE("gemm.tile", 1, mc, nc);
+                for (int i = 0; i < mc; i++) {
+                  for (int p = 0; p < kc; p++) {
+                    a_pack[i * kc + p] =
+                        alpha * s21_op_element(A, trans_a, ic + i, pc + p);
+                  }
+                }
+                for (int i = 0; i < mc; i++) {
+                  double *c_row = C->matrix[ic + i] + jc;
+                  for (int p = 0; p < kc; p++) {
+                    double a = a_pack[i * kc + p];
+                    const double *b_row = b_pack + p * nc;
+#pragma omp simd
+                    for (int j = 0; j < nc; j++) c_row[j] += a * b_row[j];
+                  }
+                }
+                S21_TRACE("gemm.tile", 0, mc, nc);
+              }
+            }
+          }
+        }
+      }
+      s21_memory_free(a_packs, a_bytes);
+      s21_memory_free(b_pack, b_bytes);
+    }
+  }
+  return flag;
+}
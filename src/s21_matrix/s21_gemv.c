@@ -0,0 +1,40 @@
+#include "s21_matrix.h"
+
+// y = alpha * op(A) * x + beta * y on contiguous vectors, op(A) is A^T when
+// trans is set. x and y must hold as many elements as op(A) has columns and
+// rows and must not overlap the storage of A. Allocates nothing.
+int s21_gemv(int trans, double alpha, matrix_t *A, const double *x,
+             double beta, double *y) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    const s21_tuning_t *tuning = s21_tuning_current();
+    int rows = A->rows, columns = A->columns;
+    int parallel = (long)rows * columns >= tuning->elementwise_threshold;
+    if (!trans) {
+#pragma omp parallel for if (parallel) schedule(static)
+      for (int i = 0; i < rows; i++) {
+        const double *a_row = A->matrix[i];
+        double dot = 0;
+#pragma omp simd reduction(+ : dot)
+        for (int j = 0; j < columns; j++) dot += a_row[j] * x[j];
+        y[i] = (beta == 0.0 ? 0.0 : beta * y[i]) + alpha * dot;
+      }
+    } else {
+      int chunk = tuning->gemv_chunk;
+#pragma omp parallel for if (parallel) schedule(static)
+      for (int j0 = 0; j0 < columns; j0 += chunk) {
+        int j1 = j0 + chunk < columns ? j0 + chunk : columns;
+        for (int j = j0; j < j1; j++) y[j] = beta == 0.0 ? 0.0 : beta * y[j];
+        for (int i = 0; i < rows; i++) {
+          const double *a_row = A->matrix[i];
+          double factor = alpha * x[i];
+#pragma omp simd
+          for (int j = j0; j < j1; j++) y[j] += factor * a_row[j];
+        }
+      }
+    }
+  }
+  return flag;
+}
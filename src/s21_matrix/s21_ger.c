@@ -0,0 +1,21 @@
+#include "s21_matrix.h"
+
+// Rank-1 update A += alpha * x * y^T, x has A->rows and y A->columns elements.
+int s21_ger(double alpha, const double *x, const double *y, matrix_t *A) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    int rows = A->rows, columns = A->columns;
+    int parallel =
+        (long)rows * columns >= s21_tuning_current()->elementwise_threshold;
+#pragma omp parallel for if (parallel) schedule(static)
+    for (int i = 0; i < rows; i++) {
+      double *a_row = A->matrix[i];
+      double factor = alpha * x[i];
+#pragma omp simd
+      for (int j = 0; j < columns; j++) a_row[j] += factor * y[j];
+    }
+  }
+  return flag;
+}
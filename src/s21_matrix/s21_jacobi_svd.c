@@ -0,0 +1,64 @@
+#include "s21_matrix.h"
+
+static double s21_row_dot(const double *x, const double *y, int length) {
+  double dot = 0;
+#pragma omp simd reduction(+ : dot)
+  for (int j = 0; j < length; j++) dot += x[j] * y[j];
+  return dot;
+}
+
+// One-sided Jacobi SVD of a wide B (rows <= columns) by rotating its rows
+// until they are mutually orthogonal: B = V * diag(sigma) * W where the rows
+// of W are orthonormal. On exit B holds W, V the accumulated rotations and
+// sigma the row norms, in no particular order.
+// V must be allocated as rows x rows.
+int s21_jacobi_svd(matrix_t *B, matrix_t *V, double *sigma) {
+  int flag = OK;
+  if (B->columns <= 0 || B->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (B->rows > B->columns || V->rows != B->rows ||
+             V->columns != B->rows) {
+    flag = CALC_ERROR;
+  } else {
+    int l = B->rows, n = B->columns;
+    for (int i = 0; i < l; i++) {
+      for (int j = 0; j < l; j++) V->matrix[i][j] = i == j ? 1.0 : 0.0;
+    }
+    int rotated = 1;
+    for (int sweep = 0; sweep < S21_JACOBI_SWEEPS && rotated; sweep++) {
+      rotated = 0;
+      for (int p = 0; p < l - 1; p++) {
+        for (int q = p + 1; q < l; q++) {
+          double *bp = B->matrix[p], *bq = B->matrix[q];
+          double alpha = s21_row_dot(bp, bp, n);
+          double beta = s21_row_dot(bq, bq, n);
+          double gamma = s21_row_dot(bp, bq, n);
+          if (fabs(gamma) > S21_EPSILON * sqrt(alpha * beta) && gamma != 0) {
+            rotated = 1;
+            double zeta = (beta - alpha) / (2.0 * gamma);
+            double t = copysign(1.0, zeta) / (fabs(zeta) + hypot(1.0, zeta));
+            double c = 1.0 / hypot(1.0, t), s = c * t;
+#pragma omp simd
+            for (int j = 0; j < n; j++) {
+              double x = bp[j], y = bq[j];
+              bp[j] = c * x - s * y;
+              bq[j] = s * x + c * y;
+            }
+            for (int i = 0; i < l; i++) {
+              double x = V->matrix[i][p], y = V->matrix[i][q];
+              V->matrix[i][p] = c * x - s * y;
+              V->matrix[i][q] = s * x + c * y;
+            }
+          }
+        }
+      }
+    }
+    for (int i = 0; i < l; i++) {
+      sigma[i] = sqrt(s21_row_dot(B->matrix[i], B->matrix[i], n));
+      if (sigma[i] > 0) {
+        for (int j = 0; j < n; j++) B->matrix[i][j] /= sigma[i];
+      }
+    }
+  }
+  return flag;
+}
@@ -0,0 +1,50 @@
+#include "s21_matrix.h"
+
+// Minimizes ||A * X - B|| for a tall A (rows >= columns) through the QR
+// decomposition of A. X must be allocated as A->columns x B->columns.
+// Returns CALC_ERROR when A does not have full column rank and MEMORY_ERROR
+// when its copy or the reflector scales do not fit the memory budget.
+int s21_least_squares(matrix_t *A, matrix_t *B, matrix_t *X) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0 || B->columns <= 0 || B->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->rows < A->columns || A->rows != B->rows ||
+             X->rows != A->columns || X->columns != B->columns) {
+    flag = CALC_ERROR;
+  } else {
+    int n = A->columns;
+    matrix_t QR = {0}, QtB = {0};
+    double *tau = s21_memory_alloc(sizeof(double) * n, 0);
+    if (tau == NULL || s21_create_matrix(A->rows, n, &QR) != OK ||
+        s21_create_matrix(B->rows, B->columns, &QtB) != OK) {
+      flag = MEMORY_ERROR;
+    } else {
+      s21_mult_number(A, 1.0, &QR);
+      s21_mult_number(B, 1.0, &QtB);
+      flag = s21_qr_decomposition(&QR, tau);
+      if (flag == OK) flag = s21_qr_apply(&QR, tau, 1, &QtB);
+      double max_diagonal = 0;
+      for (int i = 0; i < n; i++) {
+        max_diagonal = fmax(max_diagonal, fabs(QR.matrix[i][i]));
+      }
+      for (int i = 0; i < n && flag == OK; i++) {
+        if (fabs(QR.matrix[i][i]) <= max_diagonal * n * S21_EPSILON) {
+          flag = CALC_ERROR;
+        }
+      }
+      for (int i = n - 1; i >= 0 && flag == OK; i--) {
+        for (int j = 0; j < B->columns; j++) {
+          double sum = QtB.matrix[i][j];
+          for (int c = i + 1; c < n; c++) {
+            sum -= QR.matrix[i][c] * X->matrix[c][j];
+          }
+          X->matrix[i][j] = sum / QR.matrix[i][i];
+        }
+      }
+    }
+    s21_remove_matrix(&QR);
+    s21_remove_matrix(&QtB);
+    s21_memory_free(tau, sizeof(double) * n);
+  }
+  return flag;
+}
@@ -0,0 +1,82 @@
+#include "s21_matrix.h"
+
+void s21_swap_rows(matrix_t *A, int first, int second) {
+  for (int j = 0; j < A->columns; j++) {
+    double value = A->matrix[first][j];
+    A->matrix[first][j] = A->matrix[second][j];
+    A->matrix[second][j] = value;
+  }
+}
+
+// In-place LU decomposition with partial pivoting: P * A = L * U, L unit lower
+// triangular. pivots receives the row swapped with each row and sign the
+// parity of the permutation. Returns CALC_ERROR for a singular matrix.
+int s21_lu_decomposition(matrix_t *A, int *pivots, int *sign) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->columns != A->rows) {
+    flag = CALC_ERROR;
+  } else {
+    int n = A->rows;
+    S21_TRACE("lu.factor", 1, n, n);
+    *sign = 1;
+    for (int k = 0; k < n && flag == OK; k++) {
+      int pivot = k;
+      for (int i = k + 1; i < n; i++) {
+        if (fabs(A->matrix[i][k]) > fabs(A->matrix[pivot][k])) pivot = i;
+      }
+      pivots[k] = pivot;
+      if (A->matrix[pivot][k] == 0) {
+        flag = CALC_ERROR;
+      } else {
+        if (pivot != k) {
+          s21_swap_rows(A, k, pivot);
+          *sign = -*sign;
+        }
+        double *pivot_row = A->matrix[k];
+        for (int i = k + 1; i < n; i++) {
+          double *row = A->matrix[i];
+          double factor = row[k] / pivot_row[k];
+          row[k] = factor;
+          for (int j = k + 1; j < n; j++) row[j] -= factor * pivot_row[j];
+        }
+      }
+    }
+    S21_TRACE("lu.factor", 0, n, n);
+  }
+  return flag;
+}
+
+// Solves A * X = B in place of B using the factors of s21_lu_decomposition.
+int s21_lu_solve(matrix_t *LU, const int *pivots, matrix_t *B) {
+  int flag = OK;
+  if (LU->columns <= 0 || LU->rows <= 0 || B->columns <= 0 || B->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (LU->rows != LU->columns || LU->rows != B->rows) {
+    flag = CALC_ERROR;
+  } else {
+    int n = LU->rows;
+    for (int k = 0; k < n; k++) {
+      if (pivots[k] != k) s21_swap_rows(B, k, pivots[k]);
+    }
+    for (int i = 0; i < n; i++) {
+      for (int k = 0; k < i; k++) {
+        double factor = LU->matrix[i][k];
+        for (int j = 0; j < B->columns; j++) {
+          B->matrix[i][j] -= factor * B->matrix[k][j];
+        }
+      }
+    }
+    for (int i = n - 1; i >= 0; i--) {
+      for (int k = i + 1; k < n; k++) {
+        double factor = LU->matrix[i][k];
+        for (int j = 0; j < B->columns; j++) {
+          B->matrix[i][j] -= factor * B->matrix[k][j];
+        }
+      }
+      for (int j = 0; j < B->columns; j++) B->matrix[i][j] /= LU->matrix[i][i];
+    }
+  }
+  return flag;
+}
@@ -8,12 +8,27 @@ extern "C" {
 #define SUCCESS 1
 #define FAILURE 0
 
+#define S21_EPSILON 2.220446049250313e-16
+#define S21_JACOBI_SWEEPS 60
+// Defaults of the kernel tuning, used until a tuning profile is loaded.
+#define S21_GEMM_MC 64
+#define S21_GEMM_KC 256
+#define S21_GEMM_NC 512
+#define S21_QR_BLOCK 32
+#define S21_GEMV_CHUNK 512
+#define S21_PARALLEL_THRESHOLD 65536
+#define S21_TRANSPOSE_BLOCK 32
+
+#include <float.h>
+#include <limits.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-enum { OK = 0, INCORRECT_MATRIX = 1, CALC_ERROR = 2 };
+enum { OK = 0, INCORRECT_MATRIX = 1, CALC_ERROR = 2, MEMORY_ERROR = 3 };
 
 typedef struct matrix_struct {
   double **matrix;
@@ -21,6 +36,26 @@ typedef struct matrix_struct {
   int columns;
 } matrix_t;
 
+enum {
+  S21_SYMMETRIC = 0,
+  S21_UPPER_TRIANGULAR = 1,
+  S21_LOWER_TRIANGULAR = 2,
+  S21_DIAGONAL = 3,
+  S21_BANDED = 4
+};
+
+// Square size x size matrix keeping only the elements its kind allows:
+// symmetric and lower triangular store the lower triangle row by row, upper
+// triangular the upper triangle, diagonal the diagonal and banded the `lower`
+// subdiagonals and `upper` superdiagonals of every row.
+typedef struct packed_struct {
+  double *data;
+  int size;
+  int kind;
+  int lower;
+  int upper;
+} packed_t;
+
 int s21_create_matrix(const int rows, const int columns, matrix_t *result);
 void s21_remove_matrix(matrix_t *const A);
 int s21_eq_matrix(matrix_t *A, matrix_t *B);
@@ -32,6 +67,144 @@ int s21_transpose(matrix_t *A, matrix_t *result);
 int s21_calc_complements(matrix_t *A, matrix_t *result);
 int s21_determinant(matrix_t *A, double *result);
 int s21_inverse_matrix(matrix_t *A, matrix_t *result);
+int s21_gemm(int trans_a, int trans_b, double alpha, matrix_t *A, matrix_t *B,
+             double beta, matrix_t *C);
+int s21_submatrix(matrix_t *A, int row, int column, int rows, int columns,
+                  matrix_t *view);
+void s21_remove_submatrix(matrix_t *view);
+int s21_wrap_matrix(double *data, int rows, int columns, long stride,
+                    matrix_t *view);
+int s21_block_reflector_build(matrix_t *QR, const double *tau, int column,
+                              int block, matrix_t *V, matrix_t *T);
+int s21_block_reflector_apply(matrix_t *V, matrix_t *T, int transpose,
+                              matrix_t *C);
+int s21_qr_decomposition(matrix_t *A, double *tau);
+int s21_qr_apply(matrix_t *QR, const double *tau, int transpose, matrix_t *C);
+int s21_least_squares(matrix_t *A, matrix_t *B, matrix_t *X);
+int s21_gemv(int trans, double alpha, matrix_t *A, const double *x,
+             double beta, double *y);
+int s21_ger(double alpha, const double *x, const double *y, matrix_t *A);
+int s21_syrk_lower(int trans, double alpha, matrix_t *A, double beta,
+                   matrix_t *C);
+void s21_mirror_lower(matrix_t *C);
+int s21_triangular_kind(matrix_t *A);
+int s21_triangular_mult(int upper, matrix_t *A, matrix_t *B, matrix_t *C);
+int s21_axpby_matrix(double alpha, matrix_t *X, double beta, matrix_t *Y);
+int s21_jacobi_svd(matrix_t *B, matrix_t *V, double *sigma);
+int s21_tridiagonalize(matrix_t *A, double *d, double *e, double *tau);
+int s21_tridiagonal_back_transform(matrix_t *A, const double *tau, matrix_t *Z);
+int s21_tridiagonal_ql(double *d, double *e, int n, matrix_t *Z);
+int s21_tridiagonal_bisect(const double *d, const double *e, int n, int first,
+                           int last, double *w);
+int s21_tridiagonal_inverse_iteration(const double *d, const double *e, int n,
+                                      const double *w, int count, matrix_t *Z);
+void s21_swap_rows(matrix_t *A, int first, int second);
+int s21_lu_decomposition(matrix_t *A, int *pivots, int *sign);
+int s21_lu_solve(matrix_t *LU, const int *pivots, matrix_t *B);
+int s21_cholesky(matrix_t *A);
+
+// Accounting of the memory behind matrices and kernel scratch. live_bytes
+// of a thread is what it allocated minus what it freed.
+typedef struct s21_memory_stats_struct {
+  long long live_bytes;
+  long long peak_bytes;
+  long long allocations;
+  long long failures;
+} s21_memory_stats_t;
+
+void *s21_memory_alloc(size_t bytes, int zero);
+void s21_memory_free(void *block, size_t bytes);
+int s21_memory_fits(double bytes);
+void s21_memory_set_budget(long long bytes);
+long long s21_memory_budget(void);
+void s21_memory_stats(int thread, s21_memory_stats_t *stats);
+void s21_memory_reset_peak(void);
+
+// Receiver of the begin (begin = 1) and end events of internal phases such
+// as packing, panel factorizations and parallel tiles; name must be a
+// string literal. S21_TRACE costs one pointer test while no hook is set.
+typedef void (*s21_trace_hook_t)(const char *name, int begin, int rows,
+                                 int columns);
+
+extern s21_trace_hook_t s21_trace_hook;
+
+void s21_trace_set_hook(s21_trace_hook_t hook);
+
+#define S21_TRACE(name, begin, rows, columns)                          \
+  do {                                                                 \
+    if (s21_trace_hook != NULL) s21_trace_hook(name, begin, rows, columns); \
+  } while (0)
+
+// Machine-dependent kernel parameters: tile sizes and the work above which
+// a kernel goes parallel (flops for GEMM-like kernels, elements for the
+// others). Loaded at startup from the profile of this CPU, if any.
+typedef struct s21_tuning {
+  int gemm_mc, gemm_kc, gemm_nc;
+  int qr_block;
+  int gemv_chunk;
+  int transpose_block;
+  long parallel_threshold;
+  long elementwise_threshold;
+} s21_tuning_t;
+
+// The profile in use. A kernel reads it once and keeps that snapshot, so a
+// concurrent s21_tuning_publish never changes parameters under it.
+const s21_tuning_t *s21_tuning_current(void);
+int s21_tuning_publish(const s21_tuning_t *tuning);
+void s21_tuning_defaults(s21_tuning_t *tuning);
+int s21_cpu_model(char *model, size_t size);
+int s21_tuning_path(char *path, size_t size);
+int s21_tuning_load(const char *path, s21_tuning_t *tuning);
+int s21_tuning_save(const char *path, const s21_tuning_t *tuning);
+
+// A compute backend: one implementation of every heavy kernel, with the
+// argument conventions and return codes of the built-in functions.
+typedef struct s21_backend {
+  const char *name;
+  int (*gemm)(int trans_a, int trans_b, double alpha, matrix_t *A,
+              matrix_t *B, double beta, matrix_t *C);
+  int (*lu_decomposition)(matrix_t *A, int *pivots, int *sign);
+  int (*cholesky)(matrix_t *A);
+  int (*qr_decomposition)(matrix_t *A, double *tau);
+  int (*transpose)(matrix_t *A, matrix_t *result);
+  int (*axpby)(double alpha, matrix_t *X, double beta, matrix_t *Y);
+} s21_backend_t;
+
+const s21_backend_t *s21_backend_builtin(void);
+const s21_backend_t *s21_backend_blas(void);
+int s21_backend_count(void);
+const s21_backend_t *s21_backend_at(int index);
+const s21_backend_t *s21_backend_find(const char *name);
+int s21_backend_self_check(const s21_backend_t *backend,
+                           const s21_backend_t *reference);
+int s21_backend_select(const s21_backend_t *backend);
+const s21_backend_t *s21_backend_override(const s21_backend_t *backend);
+const s21_backend_t *s21_backend_current(void);
+int s21_leading_dimension(matrix_t *A);
+
+size_t s21_packed_elements(int size, int kind, int lower, int upper);
+int s21_create_packed(int size, int kind, int lower, int upper,
+                      packed_t *result);
+void s21_remove_packed(packed_t *A);
+void s21_packed_range(packed_t *A, int row, int *first, int *last);
+double *s21_packed_at(packed_t *A, int row, int column);
+double s21_packed_get(packed_t *A, int row, int column);
+int s21_packed_rows(packed_t *A, matrix_t *rows);
+int s21_pack_matrix(matrix_t *A, packed_t *result);
+int s21_unpack_matrix(packed_t *A, matrix_t *result);
+int s21_packed_mult_matrix(packed_t *A, matrix_t *B, matrix_t *result);
+void s21_packed_mult_number(packed_t *A, double number);
+int s21_packed_sum(packed_t *A, packed_t *B, double sign, packed_t *result);
+int s21_packed_transpose(packed_t *A, packed_t *result);
+int s21_packed_determinant(packed_t *A, double *result);
+int s21_packed_solve(packed_t *A, matrix_t *B, matrix_t *X);
+double *s21_band_lu_create(packed_t *A);
+void s21_band_lu_remove(packed_t *A, double *work);
+int s21_band_lu_decomposition(packed_t *A, double *work, int *pivots,
+                              int *sign);
+double s21_band_lu_diagonal(packed_t *A, double *work, int row);
+void s21_band_lu_solve(packed_t *A, double *work, const int *pivots,
+                       matrix_t *B);
 
 void s21_create_matrix_lower(matrix_t A, matrix_t *Temp, int crossed_out_row,
                              int crossed_out_column);
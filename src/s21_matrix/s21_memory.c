@@ -0,0 +1,101 @@
+#include <stdatomic.h>
+
+#include "s21_matrix.h"
+
+static atomic_llong s21_live_bytes, s21_peak_bytes, s21_allocations,
+    s21_failures, s21_budget;
+static _Thread_local s21_memory_stats_t s21_thread_stats;
+
+static void s21_raise_peak(atomic_llong *peak, long long live) {
+  long long seen = atomic_load_explicit(peak, memory_order_relaxed);
+  while (seen < live && !atomic_compare_exchange_weak_explicit(
+                            peak, &seen, live, memory_order_relaxed,
+                            memory_order_relaxed)) {
+  }
+}
+
+static void s21_count_failure(void) {
+  atomic_fetch_add_explicit(&s21_failures, 1, memory_order_relaxed);
+  s21_thread_stats.failures++;
+}
+
+// Allocates bytes, zeroed when zero is set, and charges them to the global
+// and the calling thread's account. Returns NULL when the budget would be
+// exceeded or the system is out of memory; nothing is charged then. The
+// bytes are charged only once they fit, so live bytes never wrap around.
+void *s21_memory_alloc(size_t bytes, int zero) {
+  void *block = NULL;
+  long long budget = atomic_load_explicit(&s21_budget, memory_order_relaxed);
+  long long size = bytes > (size_t)LLONG_MAX ? LLONG_MAX : (long long)bytes;
+  long long live = atomic_load_explicit(&s21_live_bytes, memory_order_relaxed);
+  int fits = 0;
+  do {
+    fits = size <= LLONG_MAX - live && (budget == 0 || size <= budget - live);
+  } while (fits && !atomic_compare_exchange_weak_explicit(
+                       &s21_live_bytes, &live, live + size,
+                       memory_order_relaxed, memory_order_relaxed));
+  if (fits) {
+    live += size;
+    block = zero ? calloc(bytes, 1) : malloc(bytes);
+    if (block == NULL && bytes > 0)
+      atomic_fetch_sub_explicit(&s21_live_bytes, size, memory_order_relaxed);
+  }
+  if (block == NULL && bytes > 0) {
+    s21_count_failure();
+  } else {
+    s21_raise_peak(&s21_peak_bytes, live);
+    atomic_fetch_add_explicit(&s21_allocations, 1, memory_order_relaxed);
+    s21_thread_stats.live_bytes += size;
+    s21_thread_stats.allocations++;
+    if (s21_thread_stats.live_bytes > s21_thread_stats.peak_bytes)
+      s21_thread_stats.peak_bytes = s21_thread_stats.live_bytes;
+  }
+  return block;
+}
+
+// Releases a block of s21_memory_alloc; bytes must be the size it was
+// allocated with.
+void s21_memory_free(void *block, size_t bytes) {
+  if (block != NULL) {
+    free(block);
+    atomic_fetch_sub_explicit(&s21_live_bytes, (long long)bytes,
+                              memory_order_relaxed);
+    s21_thread_stats.live_bytes -= (long long)bytes;
+  }
+}
+
+// Whether bytes more can be allocated without exceeding the budget; the
+// check kernels use to choose a variant with less scratch.
+int s21_memory_fits(double bytes) {
+  long long budget = atomic_load_explicit(&s21_budget, memory_order_relaxed);
+  return budget == 0 ||
+         atomic_load_explicit(&s21_live_bytes, memory_order_relaxed) + bytes <=
+             (double)budget;
+}
+
+// Limit of live bytes over all threads, 0 for none. A budget below the
+// current live bytes only fails the allocations that follow.
+void s21_memory_set_budget(long long bytes) {
+  atomic_store(&s21_budget, bytes > 0 ? bytes : 0);
+}
+
+long long s21_memory_budget(void) { return atomic_load(&s21_budget); }
+
+// Counters of all threads, or with thread set of the calling thread only,
+// whose live bytes are those it allocated minus those it freed.
+void s21_memory_stats(int thread, s21_memory_stats_t *stats) {
+  if (thread) {
+    *stats = s21_thread_stats;
+  } else {
+    stats->live_bytes = atomic_load(&s21_live_bytes);
+    stats->peak_bytes = atomic_load(&s21_peak_bytes);
+    stats->allocations = atomic_load(&s21_allocations);
+    stats->failures = atomic_load(&s21_failures);
+  }
+}
+
+// Restarts the peaks, global and of the calling thread, from the live bytes.
+void s21_memory_reset_peak(void) {
+  atomic_store(&s21_peak_bytes, atomic_load(&s21_live_bytes));
+  s21_thread_stats.peak_bytes = s21_thread_stats.live_bytes;
+}
@@ -0,0 +1,38 @@
+#include "s21_matrix.h"
+
+// Copies the structured part of a square A into result, which must already be
+// created with the wanted structure. Elements outside the structure are
+// ignored.
+int s21_pack_matrix(matrix_t *A, packed_t *result) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->rows != A->columns || A->rows != result->size) {
+    flag = CALC_ERROR;
+  } else {
+    for (int row = 0; row < result->size; row++) {
+      int first = 0, last = 0;
+      s21_packed_range(result, row, &first, &last);
+      for (int column = first; column <= last; column++) {
+        *s21_packed_at(result, row, column) = A->matrix[row][column];
+      }
+    }
+  }
+  return flag;
+}
+
+int s21_unpack_matrix(packed_t *A, matrix_t *result) {
+  int flag = OK;
+  if (result->columns <= 0 || result->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (result->rows != A->size || result->columns != A->size) {
+    flag = CALC_ERROR;
+  } else {
+    for (int row = 0; row < A->size; row++) {
+      for (int column = 0; column < A->size; column++) {
+        result->matrix[row][column] = s21_packed_get(A, row, column);
+      }
+    }
+  }
+  return flag;
+}
@@ -0,0 +1,58 @@
+#include "s21_matrix.h"
+
+static int s21_dense_determinant(packed_t *A, double *result) {
+  matrix_t dense = {0};
+  int *pivots = s21_memory_alloc(sizeof(int) * A->size, 0);
+  int sign = 1;
+  int flag = pivots == NULL ? MEMORY_ERROR
+                            : s21_create_matrix(A->size, A->size, &dense);
+  if (flag == OK) {
+    s21_unpack_matrix(A, &dense);
+    if (s21_lu_decomposition(&dense, pivots, &sign) == OK) {
+      *result = sign;
+      for (int i = 0; i < A->size; i++) *result *= dense.matrix[i][i];
+    } else {
+      *result = 0;
+    }
+  }
+  s21_remove_matrix(&dense);
+  s21_memory_free(pivots, sizeof(int) * A->size);
+  return flag;
+}
+
+static int s21_band_determinant(packed_t *A, double *result) {
+  int flag = OK;
+  int *pivots = s21_memory_alloc(sizeof(int) * A->size, 0);
+  double *work = pivots == NULL ? NULL : s21_band_lu_create(A);
+  int sign = 1;
+  if (pivots == NULL || work == NULL) {
+    flag = MEMORY_ERROR;
+  } else if (s21_band_lu_decomposition(A, work, pivots, &sign) == OK) {
+    *result = sign;
+    for (int i = 0; i < A->size; i++) {
+      *result *= s21_band_lu_diagonal(A, work, i);
+    }
+  } else {
+    *result = 0;
+  }
+  s21_band_lu_remove(A, work);
+  s21_memory_free(pivots, sizeof(int) * A->size);
+  return flag;
+}
+
+// Triangular and diagonal determinants are the product of the diagonal, banded
+// ones go through the banded LU, symmetric ones through a dense LU.
+int s21_packed_determinant(packed_t *A, double *result) {
+  int flag = OK;
+  if (A->size <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->kind == S21_SYMMETRIC) {
+    flag = s21_dense_determinant(A, result);
+  } else if (A->kind == S21_BANDED) {
+    flag = s21_band_determinant(A, result);
+  } else {
+    *result = 1;
+    for (int i = 0; i < A->size; i++) *result *= *s21_packed_at(A, i, i);
+  }
+  return flag;
+}
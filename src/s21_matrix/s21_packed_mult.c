@@ -0,0 +1,39 @@
+#include "s21_matrix.h"
+
+// result = A * B touching only the stored elements of A. Every stored element
+// of a symmetric A is read once and used for both of its mirrored positions.
+int s21_packed_mult_matrix(packed_t *A, matrix_t *B, matrix_t *result) {
+  int flag = OK;
+  if (B->columns <= 0 || B->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (B->rows != A->size || result->rows != A->size ||
+             result->columns != B->columns) {
+    flag = CALC_ERROR;
+  } else {
+    int columns = B->columns;
+    for (int row = 0; row < A->size; row++) {
+      for (int j = 0; j < columns; j++) result->matrix[row][j] = 0;
+    }
+    for (int row = 0; row < A->size; row++) {
+      int first = 0, last = 0;
+      s21_packed_range(A, row, &first, &last);
+      double *result_row = result->matrix[row];
+      for (int k = first; k <= last; k++) {
+        double a = *s21_packed_at(A, row, k);
+        const double *b_row = B->matrix[k];
+        for (int j = 0; j < columns; j++) result_row[j] += a * b_row[j];
+        if (A->kind == S21_SYMMETRIC && k != row) {
+          double *mirror_row = result->matrix[k];
+          const double *b_mirror = B->matrix[row];
+          for (int j = 0; j < columns; j++) mirror_row[j] += a * b_mirror[j];
+        }
+      }
+    }
+  }
+  return flag;
+}
+
+void s21_packed_mult_number(packed_t *A, double number) {
+  size_t elements = s21_packed_elements(A->size, A->kind, A->lower, A->upper);
+  for (size_t i = 0; i < elements; i++) A->data[i] *= number;
+}
@@ -0,0 +1,120 @@
+#include "s21_matrix.h"
+
+static int s21_triangular_solve(packed_t *A, matrix_t *X) {
+  int flag = OK;
+  int n = A->size;
+  int lower = A->kind == S21_LOWER_TRIANGULAR;
+  for (int step = 0; step < n && flag == OK; step++) {
+    int i = lower ? step : n - 1 - step;
+    int first = 0, last = 0;
+    s21_packed_range(A, i, &first, &last);
+    double diagonal = *s21_packed_at(A, i, i);
+    if (diagonal == 0) flag = CALC_ERROR;
+    for (int k = first; k <= last && flag == OK; k++) {
+      if (k == i) continue;
+      double factor = *s21_packed_at(A, i, k);
+      for (int j = 0; j < X->columns; j++) {
+        X->matrix[i][j] -= factor * X->matrix[k][j];
+      }
+    }
+    for (int j = 0; j < X->columns && flag == OK; j++) {
+      X->matrix[i][j] /= diagonal;
+    }
+  }
+  return flag;
+}
+
+// Thomas algorithm for a tridiagonal A without pivoting. Returns CALC_ERROR on
+// a vanishing pivot so that the caller can fall back to the banded LU.
+static int s21_thomas_solve(packed_t *A, matrix_t *X) {
+  int n = A->size;
+  double *upper = s21_memory_alloc(sizeof(double) * n, 0);
+  double *pivots =
+      upper == NULL ? NULL : s21_memory_alloc(sizeof(double) * n, 0);
+  int flag = pivots == NULL ? MEMORY_ERROR : OK;
+  double pivot = s21_packed_get(A, 0, 0);
+  for (int i = 0; i < n && flag == OK; i++) {
+    if (i > 0) {
+      pivot = s21_packed_get(A, i, i) -
+              s21_packed_get(A, i, i - 1) * upper[i - 1];
+    }
+    if (fabs(pivot) <= S21_EPSILON * fabs(s21_packed_get(A, i, i))) {
+      flag = CALC_ERROR;
+    } else {
+      pivots[i] = pivot;
+      upper[i] = i + 1 < n ? s21_packed_get(A, i, i + 1) / pivot : 0;
+    }
+  }
+  for (int j = 0; j < X->columns && flag == OK; j++) {
+    X->matrix[0][j] /= pivots[0];
+    for (int i = 1; i < n; i++) {
+      X->matrix[i][j] = (X->matrix[i][j] -
+                         s21_packed_get(A, i, i - 1) * X->matrix[i - 1][j]) /
+                        pivots[i];
+    }
+    for (int i = n - 2; i >= 0; i--) {
+      X->matrix[i][j] -= upper[i] * X->matrix[i + 1][j];
+    }
+  }
+  s21_memory_free(upper, sizeof(double) * n);
+  s21_memory_free(pivots, sizeof(double) * n);
+  return flag;
+}
+
+static int s21_band_solve(packed_t *A, matrix_t *X) {
+  int flag = OK;
+  int *pivots = s21_memory_alloc(sizeof(int) * A->size, 0);
+  double *work = pivots == NULL ? NULL : s21_band_lu_create(A);
+  int sign = 1;
+  if (pivots == NULL || work == NULL) {
+    flag = MEMORY_ERROR;
+  } else {
+    flag = s21_band_lu_decomposition(A, work, pivots, &sign);
+    if (flag == OK) s21_band_lu_solve(A, work, pivots, X);
+  }
+  s21_band_lu_remove(A, work);
+  s21_memory_free(pivots, sizeof(int) * A->size);
+  return flag;
+}
+
+static int s21_dense_solve(packed_t *A, matrix_t *X) {
+  matrix_t dense = {0};
+  int *pivots = s21_memory_alloc(sizeof(int) * A->size, 0);
+  int sign = 1;
+  int flag = pivots == NULL ? MEMORY_ERROR
+                            : s21_create_matrix(A->size, A->size, &dense);
+  if (flag == OK) {
+    s21_unpack_matrix(A, &dense);
+    flag = s21_lu_decomposition(&dense, pivots, &sign);
+  }
+  if (flag == OK) flag = s21_lu_solve(&dense, pivots, X);
+  s21_remove_matrix(&dense);
+  s21_memory_free(pivots, sizeof(int) * A->size);
+  return flag;
+}
+
+// Solves A * X = B. X must be allocated with the shape of B.
+int s21_packed_solve(packed_t *A, matrix_t *B, matrix_t *X) {
+  int flag = OK;
+  if (B->columns <= 0 || B->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (B->rows != A->size || X->rows != B->rows ||
+             X->columns != B->columns) {
+    flag = CALC_ERROR;
+  } else {
+    s21_mult_number(B, 1.0, X);
+    if (A->kind == S21_DIAGONAL || A->kind == S21_LOWER_TRIANGULAR ||
+        A->kind == S21_UPPER_TRIANGULAR) {
+      flag = s21_triangular_solve(A, X);
+    } else if (A->kind == S21_BANDED) {
+      if (A->lower == 1 && A->upper == 1) flag = s21_thomas_solve(A, X);
+      if (flag == CALC_ERROR || A->lower != 1 || A->upper != 1) {
+        s21_mult_number(B, 1.0, X);
+        flag = s21_band_solve(A, X);
+      }
+    } else {
+      flag = s21_dense_solve(A, X);
+    }
+  }
+  return flag;
+}
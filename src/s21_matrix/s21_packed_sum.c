@@ -0,0 +1,21 @@
+#include "s21_matrix.h"
+
+// result = A + sign * B. result must be created with a structure able to hold
+// the structures of both operands.
+int s21_packed_sum(packed_t *A, packed_t *B, double sign, packed_t *result) {
+  int flag = OK;
+  if (A->size != B->size || A->size != result->size) {
+    flag = CALC_ERROR;
+  } else {
+    for (int row = 0; row < result->size; row++) {
+      int first = 0, last = 0;
+      s21_packed_range(result, row, &first, &last);
+      for (int column = first; column <= last; column++) {
+        *s21_packed_at(result, row, column) =
+            s21_packed_get(A, row, column) +
+            sign * s21_packed_get(B, row, column);
+      }
+    }
+  }
+  return flag;
+}
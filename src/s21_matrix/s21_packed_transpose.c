@@ -0,0 +1,24 @@
+#include "s21_matrix.h"
+
+// result must be created with the transposed structure: triangular kinds swap,
+// banded matrices swap their lower and upper bandwidths.
+int s21_packed_transpose(packed_t *A, packed_t *result) {
+  int flag = OK;
+  if (A->size != result->size) {
+    flag = CALC_ERROR;
+  } else {
+    for (int row = 0; row < A->size; row++) {
+      int first = 0, last = 0;
+      s21_packed_range(A, row, &first, &last);
+      for (int column = first; column <= last; column++) {
+        double *element = s21_packed_at(result, column, row);
+        if (element == NULL) {
+          flag = CALC_ERROR;
+        } else {
+          *element = *s21_packed_at(A, row, column);
+        }
+      }
+    }
+  }
+  return flag;
+}
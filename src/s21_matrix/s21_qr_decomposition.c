@@ -0,0 +1,105 @@
+#include "s21_matrix.h"
+
+// Generates the reflector for column `column` starting at row `column` and
+// applies it to the panel columns (column, last).
+static void s21_householder_panel(matrix_t *A, double *tau, int column,
+                                  int last) {
+  double alpha = A->matrix[column][column];
+  double xnorm = 0;
+  for (int i = column + 1; i < A->rows; i++) {
+    xnorm = hypot(xnorm, A->matrix[i][column]);
+  }
+  tau[column] = 0;
+  if (xnorm != 0) {
+    double beta = -copysign(hypot(alpha, xnorm), alpha);
+    tau[column] = (beta - alpha) / beta;
+    double scale = 1.0 / (alpha - beta);
+    for (int i = column + 1; i < A->rows; i++) A->matrix[i][column] *= scale;
+    A->matrix[column][column] = beta;
+    for (int j = column + 1; j < last; j++) {
+      double w = A->matrix[column][j];
+      for (int i = column + 1; i < A->rows; i++) {
+        w += A->matrix[i][column] * A->matrix[i][j];
+      }
+      w *= tau[column];
+      A->matrix[column][j] -= w;
+      for (int i = column + 1; i < A->rows; i++) {
+        A->matrix[i][j] -= w * A->matrix[i][column];
+      }
+    }
+  }
+}
+
+// Blocked Householder QR. On exit R is stored on and above the diagonal of A,
+// the Householder vectors below it and their scalar factors in tau, which
+// must hold min(rows, columns) elements. Near the memory budget the panels
+// narrow, down to unblocked reflections without scratch.
+int s21_qr_decomposition(matrix_t *A, double *tau) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    int k = A->rows < A->columns ? A->rows : A->columns;
+    int nb = s21_tuning_current()->qr_block;
+    while (nb > 1 && !s21_memory_fits(sizeof(double) * nb *
+                                      (A->rows + nb + 2.0 * A->columns))) {
+      nb /= 2;
+    }
+    for (int j = 0; j < k && flag == OK; j += nb) {
+      int block = k - j < nb ? k - j : nb;
+      int last = nb == 1 ? A->columns : j + block;
+      S21_TRACE("qr.panel", 1, A->rows - j, block);
+      for (int c = j; c < j + block; c++) {
+        s21_householder_panel(A, tau, c, last);
+      }
+      S21_TRACE("qr.panel", 0, A->rows - j, block);
+      if (last < A->columns) {
+        S21_TRACE("qr.update", 1, A->rows - j, A->columns - j - block);
+        matrix_t V = {0}, T = {0}, trailing = {0};
+        flag = s21_block_reflector_build(A, tau, j, block, &V, &T);
+        if (flag == OK)
+          flag = s21_submatrix(A, j, j + block, A->rows - j,
+                               A->columns - j - block, &trailing);
+        if (flag == OK) flag = s21_block_reflector_apply(&V, &T, 1, &trailing);
+        s21_remove_submatrix(&trailing);
+        s21_remove_matrix(&V);
+        s21_remove_matrix(&T);
+        S21_TRACE("qr.update", 0, A->rows - j, A->columns - j - block);
+      }
+    }
+  }
+  return flag;
+}
+
+// C = Q * C or, when transpose is set, C = Q^T * C for the Q stored in QR by
+// s21_qr_decomposition. The blocks narrow near the memory budget as well.
+int s21_qr_apply(matrix_t *QR, const double *tau, int transpose, matrix_t *C) {
+  int flag = OK;
+  if (QR->columns <= 0 || QR->rows <= 0 || C->columns <= 0 || C->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (QR->rows != C->rows) {
+    flag = CALC_ERROR;
+  } else {
+    int k = QR->rows < QR->columns ? QR->rows : QR->columns;
+    int nb = s21_tuning_current()->qr_block;
+    while (nb > 1 && !s21_memory_fits(sizeof(double) * nb *
+                                      (QR->rows + nb + 2.0 * C->columns))) {
+      nb /= 2;
+    }
+    int blocks = (k + nb - 1) / nb;
+    for (int b = 0; b < blocks && flag == OK; b++) {
+      int j = (transpose ? b : blocks - 1 - b) * nb;
+      int block = k - j < nb ? k - j : nb;
+      matrix_t V = {0}, T = {0}, lower = {0};
+      flag = s21_block_reflector_build(QR, tau, j, block, &V, &T);
+      if (flag == OK)
+        flag = s21_submatrix(C, j, 0, C->rows - j, C->columns, &lower);
+      if (flag == OK)
+        flag = s21_block_reflector_apply(&V, &T, transpose, &lower);
+      s21_remove_submatrix(&lower);
+      s21_remove_matrix(&V);
+      s21_remove_matrix(&T);
+    }
+  }
+  return flag;
+}
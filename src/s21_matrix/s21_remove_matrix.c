@@ -1,10 +1,12 @@
 #include "s21_matrix.h"
 
 void s21_remove_matrix(matrix_t *A) {
-  for (int i = 0; i < A->rows; i++) {
-    free(A->matrix[i]);
+  if (A->matrix != NULL && A->rows > 0) {
+    s21_memory_free(A->matrix[0],
+                    sizeof(double) * A->rows * (size_t)A->columns);
   }
-  free(A->matrix);
+  s21_memory_free(A->matrix, sizeof(double *) * (A->rows > 0 ? A->rows : 0));
+  A->matrix = NULL;
   A->columns = 0;
   A->rows = 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,53 @@
+#include "s21_matrix.h"
+
+// Builds a rows x columns view of A starting at (row, column). Only the row
+// pointer array is allocated, the elements are shared with A. Returns
+// MEMORY_ERROR when that array cannot be allocated.
+int s21_submatrix(matrix_t *A, int row, int column, int rows, int columns,
+                  matrix_t *view) {
+  int flag = OK;
+  if (rows <= 0 || columns <= 0 || row < 0 || column < 0 ||
+      row + rows > A->rows || column + columns > A->columns) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    view->matrix = s21_memory_alloc(sizeof(double *) * rows, 0);
+    if (view->matrix == NULL) {
+      flag = MEMORY_ERROR;
+    } else {
+      view->rows = rows;
+      view->columns = columns;
+      for (int i = 0; i < rows; i++) {
+        view->matrix[i] = A->matrix[row + i] + column;
+      }
+    }
+  }
+  return flag;
+}
+
+// Builds a rows x columns view of external row-major storage whose rows are
+// stride elements apart. Release with s21_remove_submatrix; data is not
+// freed.
+int s21_wrap_matrix(double *data, int rows, int columns, long stride,
+                    matrix_t *view) {
+  int flag = OK;
+  if (data == NULL || rows <= 0 || columns <= 0 || stride < columns) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    view->matrix = s21_memory_alloc(sizeof(double *) * rows, 0);
+    if (view->matrix == NULL) {
+      flag = MEMORY_ERROR;
+    } else {
+      view->rows = rows;
+      view->columns = columns;
+      for (int i = 0; i < rows; i++) view->matrix[i] = data + i * stride;
+    }
+  }
+  return flag;
+}
+
+void s21_remove_submatrix(matrix_t *view) {
+  s21_memory_free(view->matrix, sizeof(double *) * view->rows);
+  view->matrix = NULL;
+  view->columns = 0;
+  view->rows = 0;
+}
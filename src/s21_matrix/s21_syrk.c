@@ -0,0 +1,57 @@
+#include "s21_matrix.h"
+
+// Lower triangle of C = alpha * op(A) * op(A)^T + beta * C where op(A) is A,
+// or A^T when trans is set, read straight from the storage of A. Row blocks
+// of C are handed out dynamically because their triangular parts differ in
+// size. The strict upper triangle of C is left untouched.
+int s21_syrk_lower(int trans, double alpha, matrix_t *A, double beta,
+                   matrix_t *C) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0 || C->columns <= 0 || C->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    int n = trans ? A->columns : A->rows;
+    int k = trans ? A->rows : A->columns;
+    if (C->rows != n || C->columns != n) {
+      flag = CALC_ERROR;
+    } else {
+      const s21_tuning_t *tuning = s21_tuning_current();
+      int parallel = (double)n * n * k >= 2.0 * tuning->parallel_threshold;
+      int tile = tuning->gemm_mc, blocks = (n + tile - 1) / tile;
+#pragma omp parallel for if (parallel) schedule(dynamic)
+      for (int block = 0; block < blocks; block++) {
+        int first = block * tile;
+        int last = first + tile < n ? first + tile : n;
+        for (int i = first; i < last; i++) {
+          double *c_row = C->matrix[i];
+          for (int j = 0; j <= i; j++) {
+            c_row[j] = beta == 0.0 ? 0.0 : beta * c_row[j];
+          }
+          for (int j = 0; j <= i && !trans; j++) {
+            const double *a_row = A->matrix[i], *b_row = A->matrix[j];
+            double dot = 0;
+#pragma omp simd reduction(+ : dot)
+            for (int p = 0; p < k; p++) dot += a_row[p] * b_row[p];
+            c_row[j] += alpha * dot;
+          }
+        }
+        for (int p = 0; p < k && trans; p++) {
+          const double *a_row = A->matrix[p];
+          for (int i = first; i < last; i++) {
+            double *c_row = C->matrix[i];
+            double factor = alpha * a_row[i];
+#pragma omp simd
+            for (int j = 0; j <= i; j++) c_row[j] += factor * a_row[j];
+          }
+        }
+      }
+    }
+  }
+  return flag;
+}
+
+void s21_mirror_lower(matrix_t *C) {
+  for (int i = 0; i < C->rows; i++) {
+    for (int j = i + 1; j < C->columns; j++) C->matrix[i][j] = C->matrix[j][i];
+  }
+}
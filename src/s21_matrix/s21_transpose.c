@@ -1,16 +1,28 @@
 #include "s21_matrix.h"
 
+// Copies A^T into result in square tiles, so both the reads and the writes
+// stay within a few cache lines per tile.
 int s21_transpose(matrix_t *A, matrix_t *result) {
   int flag = OK;
   if (A->columns <= 0 || A->rows <= 0) {
     flag = INCORRECT_MATRIX;
   } else {
-    // s21_create_matrix(A->columns, A->rows, result);
-    for (int row = 0; row < A->rows; row++) {
-      for (int column = 0; column < A->columns; column++) {
-        result->matrix[column][row] = A->matrix[row][column];
+    int rows = A->rows, columns = A->columns;
+    const s21_tuning_t *tuning = s21_tuning_current();
+    int tile = tuning->transpose_block;
+    int parallel = (long)rows * columns >= tuning->elementwise_threshold;
+#pragma omp parallel for if (parallel) schedule(static)
+    for (int row0 = 0; row0 < rows; row0 += tile) {
+      int row1 = row0 + tile < rows ? row0 + tile : rows;
+      for (int column0 = 0; column0 < columns; column0 += tile) {
+        int column1 = column0 + tile < columns ? column0 + tile : columns;
+        for (int row = row0; row < row1; row++) {
+          for (int column = column0; column < column1; column++) {
+            result->matrix[column][row] = A->matrix[row][column];
+          }
+        }
       }
     }
   }
   return flag;
-}
\ No newline at end of file
+}
@@ -0,0 +1,57 @@
+#include "s21_matrix.h"
+
+// S21_DIAGONAL, S21_UPPER_TRIANGULAR or S21_LOWER_TRIANGULAR when every element
+// outside that structure of a square A is zero, -1 otherwise.
+int s21_triangular_kind(matrix_t *A) {
+  int upper = 1, lower = 1;
+  for (int i = 0; i < A->rows && (upper || lower); i++) {
+    for (int j = 0; j < A->columns; j++) {
+      if (A->matrix[i][j] != 0) {
+        if (j < i) upper = 0;
+        if (j > i) lower = 0;
+      }
+    }
+  }
+  int kind = -1;
+  if (A->rows != A->columns) {
+    kind = -1;
+  } else if (upper && lower) {
+    kind = S21_DIAGONAL;
+  } else if (upper) {
+    kind = S21_UPPER_TRIANGULAR;
+  } else if (lower) {
+    kind = S21_LOWER_TRIANGULAR;
+  }
+  return kind;
+}
+
+// C = A * B for two upper (or two lower) triangular matrices, only the
+// nonzero products are formed: about n^3 / 3 flops instead of 2 n^3.
+int s21_triangular_mult(int upper, matrix_t *A, matrix_t *B, matrix_t *C) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0 || B->columns <= 0 || B->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->rows != A->columns || B->rows != B->columns ||
+             A->rows != B->rows || C->rows != A->rows ||
+             C->columns != A->rows) {
+    flag = CALC_ERROR;
+  } else {
+    int n = A->rows;
+    int parallel =
+        (double)n * n * n >= 3.0 * s21_tuning_current()->parallel_threshold;
+#pragma omp parallel for if (parallel) schedule(dynamic, 16)
+    for (int i = 0; i < n; i++) {
+      double *c_row = C->matrix[i];
+      for (int j = 0; j < n; j++) c_row[j] = 0;
+      int first = upper ? i : 0, last = upper ? n - 1 : i;
+      for (int p = first; p <= last; p++) {
+        double a = A->matrix[i][p];
+        const double *b_row = B->matrix[p];
+        int from = upper ? p : 0, to = upper ? n - 1 : p;
+#pragma omp simd
+        for (int j = from; j <= to; j++) c_row[j] += a * b_row[j];
+      }
+    }
+  }
+  return flag;
+}
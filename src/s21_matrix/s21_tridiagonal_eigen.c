@@ -0,0 +1,244 @@
+#include "s21_matrix.h"
+
+#define S21_INVERSE_ITERATIONS 3
+
+// Sorts the eigenvalues ascending, carrying the columns of Z along.
+static void s21_sort_eigen(double *d, int n, matrix_t *Z) {
+  for (int i = 0; i < n - 1; i++) {
+    int k = i;
+    for (int j = i + 1; j < n; j++) {
+      if (d[j] < d[k]) k = j;
+    }
+    if (k != i) {
+      double t = d[i];
+      d[i] = d[k];
+      d[k] = t;
+      for (int r = 0; Z != NULL && r < Z->rows; r++) {
+        t = Z->matrix[r][i];
+        Z->matrix[r][i] = Z->matrix[r][k];
+        Z->matrix[r][k] = t;
+      }
+    }
+  }
+}
+
+// Implicit QL with Wilkinson shifts on the symmetric tridiagonal matrix with
+// diagonal d and off-diagonal e[0..n-2] (e[i] couples i and i + 1). On exit d
+// holds the eigenvalues in ascending order and e is destroyed. When Z is not
+// NULL its columns receive the rotations: start from the identity to get the
+// eigenvectors of T, or from Q to get those of A. Z must have n columns.
+int s21_tridiagonal_ql(double *d, double *e, int n, matrix_t *Z) {
+  S21_TRACE("tridiagonal.ql", 1, n, n);
+  int flag = n <= 0 ? INCORRECT_MATRIX : OK;
+  if (flag == OK && Z != NULL && Z->columns != n) flag = CALC_ERROR;
+  if (flag == OK) e[n - 1] = 0;
+  for (int l = 0; flag == OK && l < n; l++) {
+    int iter = 0, m;
+    do {
+      for (m = l; m < n - 1; m++) {
+        double dd = fabs(d[m]) + fabs(d[m + 1]);
+        if (fabs(e[m]) <= S21_EPSILON * dd) break;
+      }
+      if (m != l) {
+        if (iter++ == S21_JACOBI_SWEEPS) {
+          flag = CALC_ERROR;
+          break;
+        }
+        double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+        double r = hypot(g, 1.0);
+        g = d[m] - d[l] + e[l] / (g + copysign(r, g));
+        double s = 1.0, c = 1.0, p = 0.0;
+        int i;
+        for (i = m - 1; i >= l; i--) {
+          double f = s * e[i], b = c * e[i];
+          e[i + 1] = r = hypot(f, g);
+          if (r == 0.0) {
+            d[i + 1] -= p;
+            e[m] = 0.0;
+            break;
+          }
+          s = f / r;
+          c = g / r;
+          g = d[i + 1] - p;
+          r = (d[i] - g) * s + 2.0 * c * b;
+          d[i + 1] = g + (p = s * r);
+          g = c * r - b;
+          for (int k = 0; Z != NULL && k < Z->rows; k++) {
+            double *z = Z->matrix[k];
+            f = z[i + 1];
+            z[i + 1] = s * z[i] + c * f;
+            z[i] = c * z[i] - s * f;
+          }
+        }
+        if (r == 0.0 && i >= l) continue;
+        d[l] -= p;
+        e[l] = g;
+        e[m] = 0.0;
+      }
+    } while (m != l);
+  }
+  if (flag == OK) s21_sort_eigen(d, n, Z);
+  S21_TRACE("tridiagonal.ql", 0, n, n);
+  return flag;
+}
+
+// Number of eigenvalues of the tridiagonal matrix smaller than x (Sturm).
+static int s21_sturm_count(const double *d, const double *e, int n, double x,
+                           double pivmin) {
+  int count = 0;
+  double q = 1.0;
+  for (int i = 0; i < n; i++) {
+    q = d[i] - x - (i > 0 ? e[i - 1] * e[i - 1] / q : 0.0);
+    if (fabs(q) < pivmin) q = -pivmin;
+    if (q < 0) count++;
+  }
+  return count;
+}
+
+static double s21_tridiagonal_norm(const double *d, const double *e, int n) {
+  double norm = 0;
+  for (int i = 0; i < n; i++) {
+    double row = fabs(d[i]) + (i > 0 ? fabs(e[i - 1]) : 0.0) +
+                 (i < n - 1 ? fabs(e[i]) : 0.0);
+    if (row > norm) norm = row;
+  }
+  return norm;
+}
+
+// Eigenvalues first..last (0-based, ascending, inclusive) of the tridiagonal
+// matrix by bisection on Sturm counts, O(n) per step and per eigenvalue.
+int s21_tridiagonal_bisect(const double *d, const double *e, int n, int first,
+                           int last, double *w) {
+  S21_TRACE("tridiagonal.bisect", 1, n, last - first + 1);
+  int flag = OK;
+  if (n <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (first < 0 || last >= n || first > last) {
+    flag = CALC_ERROR;
+  } else {
+    double norm = s21_tridiagonal_norm(d, e, n);
+    double pivmin = DBL_MIN / DBL_EPSILON * (1.0 + norm);
+    for (int k = first; k <= last; k++) {
+      double low = -norm - pivmin, high = norm + pivmin;
+      if (k > first && w[k - first - 1] > low &&
+          s21_sturm_count(d, e, n, w[k - first - 1], pivmin) <= k) {
+        low = w[k - first - 1];
+      }
+      while (high - low > 2.0 * DBL_EPSILON * (fabs(low) + fabs(high)) +
+                              pivmin) {
+        double middle = 0.5 * (low + high);
+        if (middle <= low || middle >= high) break;
+        if (s21_sturm_count(d, e, n, middle, pivmin) > k) {
+          high = middle;
+        } else {
+          low = middle;
+        }
+      }
+      w[k - first] = 0.5 * (low + high);
+    }
+  }
+  S21_TRACE("tridiagonal.bisect", 0, n, last - first + 1);
+  return flag;
+}
+
+// Solves (T - shift * I) x = x in place by Gaussian elimination with partial
+// pivoting; exactly singular pivots are replaced by tiny.
+static void s21_shifted_solve(const double *d, const double *e, int n,
+                              double shift, double tiny, double *x,
+                              double *work) {
+  double *diag = work, *up1 = work + n, *up2 = work + 2 * n,
+         *mult = work + 3 * n;
+  int *swapped = (int *)(work + 4 * n);
+  for (int i = 0; i < n; i++) {
+    diag[i] = d[i] - shift;
+    up1[i] = i < n - 1 ? e[i] : 0.0;
+    up2[i] = 0.0;
+  }
+  for (int i = 0; i < n - 1; i++) {
+    double below = e[i];
+    swapped[i] = fabs(below) > fabs(diag[i]);
+    if (swapped[i]) {
+      double next_diag = d[i + 1] - shift;
+      double next_up = i + 1 < n - 1 ? e[i + 1] : 0.0;
+      mult[i] = diag[i] / below;
+      diag[i] = below;
+      double u1 = up1[i];
+      up1[i] = next_diag;
+      up2[i] = next_up;
+      diag[i + 1] = u1 - mult[i] * next_diag;
+      up1[i + 1] = -mult[i] * next_up;
+    } else {
+      if (diag[i] == 0) diag[i] = tiny;
+      mult[i] = below / diag[i];
+      diag[i + 1] -= mult[i] * up1[i];
+    }
+  }
+  if (diag[n - 1] == 0) diag[n - 1] = tiny;
+  for (int i = 0; i < n - 1; i++) {
+    if (swapped[i]) {
+      double t = x[i];
+      x[i] = x[i + 1];
+      x[i + 1] = t;
+    }
+    x[i + 1] -= mult[i] * x[i];
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    double sum = x[i];
+    if (i + 1 < n) sum -= up1[i] * x[i + 1];
+    if (i + 2 < n) sum -= up2[i] * x[i + 2];
+    x[i] = sum / diag[i];
+  }
+}
+
+// Eigenvectors of the tridiagonal matrix for the count eigenvalues w (from
+// s21_tridiagonal_bisect) by inverse iteration into the columns of the n x
+// count matrix Z. Vectors of close eigenvalues are reorthogonalized.
+int s21_tridiagonal_inverse_iteration(const double *d, const double *e, int n,
+                                      const double *w, int count, matrix_t *Z) {
+  S21_TRACE("tridiagonal.inverse_iteration", 1, n, count);
+  int flag = OK;
+  if (n <= 0 || count <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (Z->rows != n || Z->columns != count) {
+    flag = CALC_ERROR;
+  } else {
+    double norm = s21_tridiagonal_norm(d, e, n);
+    double tiny = DBL_EPSILON * (norm > 0 ? norm : 1.0);
+    double cluster = 1e-3 * (norm > 0 ? norm : 1.0);
+    size_t work_bytes = (sizeof(double) * 4 + sizeof(int)) * n;
+    double *x = s21_memory_alloc(sizeof(double) * n, 0);
+    double *work = x == NULL ? NULL : s21_memory_alloc(work_bytes, 0);
+    if (work == NULL) flag = MEMORY_ERROR;
+    int cluster_start = 0;
+    for (int k = 0; k < count && flag == OK; k++) {
+      if (k > 0 && w[k] - w[k - 1] > cluster) cluster_start = k;
+      unsigned seed = 2463534242u + 97u * (unsigned)k;
+      for (int i = 0; i < n; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        x[i] = (double)(seed % 2001u) / 1000.0 - 1.0;
+      }
+      for (int iteration = 0; iteration < S21_INVERSE_ITERATIONS; iteration++) {
+        s21_shifted_solve(d, e, n, w[k], tiny, x, work);
+        for (int j = cluster_start; j < k; j++) {
+          double dot = 0;
+          for (int i = 0; i < n; i++) dot += Z->matrix[i][j] * x[i];
+          for (int i = 0; i < n; i++) x[i] -= dot * Z->matrix[i][j];
+        }
+        double length = 0;
+        for (int i = 0; i < n; i++) length = hypot(length, x[i]);
+        if (length == 0) {
+          x[k % n] = 1.0;
+          length = 1.0;
+        }
+        for (int i = 0; i < n; i++) x[i] /= length;
+      }
+      for (int i = 0; i < n; i++) Z->matrix[i][k] = x[i];
+    }
+    s21_memory_free(x, sizeof(double) * n);
+    s21_memory_free(work, work_bytes);
+  }
+  S21_TRACE("tridiagonal.inverse_iteration", 0, n, count);
+  return flag;
+}
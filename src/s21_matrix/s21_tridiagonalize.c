@@ -0,0 +1,144 @@
+#include "s21_matrix.h"
+
+// Applies the reflectors already collected in the panel (columns [0, count)
+// of V and W) to column j of A, rows j..n-1.
+static void s21_panel_update_column(matrix_t *A, matrix_t *V, matrix_t *W,
+                                    int count, int j) {
+  for (int r = j; r < A->rows; r++) {
+    double sum = 0;
+    for (int c = 0; c < count; c++) {
+      sum += V->matrix[r][c] * W->matrix[j][c] +
+             W->matrix[r][c] * V->matrix[j][c];
+    }
+    A->matrix[r][j] -= sum;
+  }
+}
+
+// w = tau * A_cur * v - tau / 2 * (w^T v) * v with A_cur the trailing matrix
+// A[j+1:, j+1:] updated by the reflectors already in the panel.
+static void s21_panel_reflector_w(matrix_t *A, matrix_t *V, matrix_t *W,
+                                  int count, int j, double tau, double *t1,
+                                  double *t2) {
+  int n = A->rows, column = count;
+  for (int c = 0; c < count; c++) {
+    t1[c] = 0;
+    t2[c] = 0;
+    for (int r = j + 1; r < n; r++) {
+      t1[c] += W->matrix[r][c] * V->matrix[r][column];
+      t2[c] += V->matrix[r][c] * V->matrix[r][column];
+    }
+  }
+  double dot = 0;
+  for (int r = j + 1; r < n; r++) {
+    const double *a_row = A->matrix[r];
+    double sum = 0;
+    for (int c = j + 1; c < n; c++) sum += a_row[c] * V->matrix[c][column];
+    for (int c = 0; c < count; c++) {
+      sum -= V->matrix[r][c] * t1[c] + W->matrix[r][c] * t2[c];
+    }
+    W->matrix[r][column] = tau * sum;
+    dot += W->matrix[r][column] * V->matrix[r][column];
+  }
+  double alpha = -0.5 * tau * dot;
+  for (int r = j + 1; r < n; r++) {
+    W->matrix[r][column] += alpha * V->matrix[r][column];
+  }
+}
+
+// Blocked Householder reduction of a symmetric A (both triangles stored) to
+// tridiagonal form Q^T A Q = T: d receives the diagonal of T, e the n - 1
+// off-diagonal elements and tau the n - 1 reflector factors. The reflector
+// vectors are left below the subdiagonal of A, like a QR of A[1:, :n-1].
+// Inside a panel the reflectors are applied lazily through V and W, the
+// trailing matrix is then updated with A -= V W^T + W V^T as two GEMMs.
+// Near the memory budget the panels narrow.
+int s21_tridiagonalize(matrix_t *A, double *d, double *e, double *tau) {
+  int flag = OK;
+  if (A->columns <= 0 || A->rows <= 0) {
+    flag = INCORRECT_MATRIX;
+  } else if (A->rows != A->columns) {
+    flag = CALC_ERROR;
+  } else {
+    int n = A->rows, nb = s21_tuning_current()->qr_block;
+    while (nb > 1 && !s21_memory_fits(sizeof(double) * (2.0 * n + 2) * nb)) {
+      nb /= 2;
+    }
+    matrix_t V = {0}, W = {0};
+    double *t1 = s21_memory_alloc(sizeof(double) * nb, 0);
+    double *t2 = s21_memory_alloc(sizeof(double) * nb, 0);
+    if (t1 == NULL || t2 == NULL || s21_create_matrix(n, nb, &V) != OK ||
+        s21_create_matrix(n, nb, &W) != OK) {
+      flag = MEMORY_ERROR;
+    }
+    for (int k = 0; k < n - 1 && flag == OK; k += nb) {
+      int block = n - 1 - k < nb ? n - 1 - k : nb;
+      for (int r = 0; r < n; r++) {
+        for (int c = 0; c < block; c++) V.matrix[r][c] = W.matrix[r][c] = 0;
+      }
+      S21_TRACE("tridiagonal.panel", 1, n - k, block);
+      for (int i = 0; i < block; i++) {
+        int j = k + i;
+        s21_panel_update_column(A, &V, &W, i, j);
+        double alpha = A->matrix[j + 1][j];
+        double xnorm = 0;
+        for (int r = j + 2; r < n; r++) xnorm = hypot(xnorm, A->matrix[r][j]);
+        tau[j] = 0;
+        e[j] = alpha;
+        if (xnorm != 0) {
+          double beta = -copysign(hypot(alpha, xnorm), alpha);
+          tau[j] = (beta - alpha) / beta;
+          for (int r = j + 2; r < n; r++) A->matrix[r][j] /= alpha - beta;
+          e[j] = beta;
+        }
+        V.matrix[j + 1][i] = 1.0;
+        for (int r = j + 2; r < n; r++) V.matrix[r][i] = A->matrix[r][j];
+        s21_panel_reflector_w(A, &V, &W, i, j, tau[j], t1, t2);
+        A->matrix[j + 1][j] = e[j];
+        d[j] = A->matrix[j][j];
+      }
+      S21_TRACE("tridiagonal.panel", 0, n - k, block);
+      int next = k + block;
+      if (next < n) {
+        S21_TRACE("tridiagonal.update", 1, n - next, n - next);
+        matrix_t trailing = {0}, v_rest = {0}, w_rest = {0};
+        flag = s21_submatrix(A, next, next, n - next, n - next, &trailing);
+        if (flag == OK)
+          flag = s21_submatrix(&V, next, 0, n - next, block, &v_rest);
+        if (flag == OK)
+          flag = s21_submatrix(&W, next, 0, n - next, block, &w_rest);
+        if (flag == OK)
+          flag = s21_gemm(0, 1, -1.0, &v_rest, &w_rest, 1.0, &trailing);
+        if (flag == OK)
+          flag = s21_gemm(0, 1, -1.0, &w_rest, &v_rest, 1.0, &trailing);
+        s21_remove_submatrix(&trailing);
+        s21_remove_submatrix(&v_rest);
+        s21_remove_submatrix(&w_rest);
+        S21_TRACE("tridiagonal.update", 0, n - next, n - next);
+      }
+    }
+    d[n - 1] = A->matrix[n - 1][n - 1];
+    s21_remove_matrix(&V);
+    s21_remove_matrix(&W);
+    s21_memory_free(t1, sizeof(double) * nb);
+    s21_memory_free(t2, sizeof(double) * nb);
+  }
+  return flag;
+}
+
+// Z = Q * Z for the Q of s21_tridiagonalize; Z has n rows.
+int s21_tridiagonal_back_transform(matrix_t *A, const double *tau,
+                                   matrix_t *Z) {
+  int flag = OK;
+  if (Z->rows != A->rows) {
+    flag = CALC_ERROR;
+  } else if (A->rows > 1) {
+    int n = A->rows;
+    matrix_t reflectors = {0}, lower = {0};
+    flag = s21_submatrix(A, 1, 0, n - 1, n - 1, &reflectors);
+    if (flag == OK) flag = s21_submatrix(Z, 1, 0, n - 1, Z->columns, &lower);
+    if (flag == OK) flag = s21_qr_apply(&reflectors, tau, 0, &lower);
+    s21_remove_submatrix(&reflectors);
+    s21_remove_submatrix(&lower);
+  }
+  return flag;
+}
@@ -0,0 +1,192 @@
+#include <stdatomic.h>
+
+#include "s21_matrix.h"
+
+// Published profiles form a list from the newest; replaced ones are kept,
+// since a running kernel may still read them. Profiles are published once
+// at startup and a few dozen times while tuning.
+typedef struct s21_published_tuning {
+  s21_tuning_t tuning;
+  struct s21_published_tuning *previous;
+} s21_published_tuning_t;
+
+static s21_published_tuning_t s21_default_tuning = {
+    .tuning = {.gemm_mc = S21_GEMM_MC,
+               .gemm_kc = S21_GEMM_KC,
+               .gemm_nc = S21_GEMM_NC,
+               .qr_block = S21_QR_BLOCK,
+               .gemv_chunk = S21_GEMV_CHUNK,
+               .transpose_block = S21_TRANSPOSE_BLOCK,
+               .parallel_threshold = S21_PARALLEL_THRESHOLD,
+               .elementwise_threshold = S21_PARALLEL_THRESHOLD},
+    .previous = NULL};
+
+static _Atomic(s21_published_tuning_t *) s21_tuning_latest =
+    &s21_default_tuning;
+
+const s21_tuning_t *s21_tuning_current(void) {
+  return &atomic_load_explicit(&s21_tuning_latest, memory_order_acquire)
+              ->tuning;
+}
+
+// Makes a copy of tuning the profile of the kernels that start afterwards.
+// Without memory the current profile stays and MEMORY_ERROR is returned.
+int s21_tuning_publish(const s21_tuning_t *tuning) {
+  int flag = OK;
+  s21_published_tuning_t *published = malloc(sizeof(*published));
+  if (published == NULL) {
+    flag = MEMORY_ERROR;
+  } else {
+    published->tuning = *tuning;
+    published->previous =
+        atomic_load_explicit(&s21_tuning_latest, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(
+        &s21_tuning_latest, &published->previous, published,
+        memory_order_release, memory_order_relaxed)) {
+    }
+  }
+  return flag;
+}
+
+void s21_tuning_defaults(s21_tuning_t *tuning) {
+  tuning->gemm_mc = S21_GEMM_MC;
+  tuning->gemm_kc = S21_GEMM_KC;
+  tuning->gemm_nc = S21_GEMM_NC;
+  tuning->qr_block = S21_QR_BLOCK;
+  tuning->gemv_chunk = S21_GEMV_CHUNK;
+  tuning->transpose_block = S21_TRANSPOSE_BLOCK;
+  tuning->parallel_threshold = S21_PARALLEL_THRESHOLD;
+  tuning->elementwise_threshold = S21_PARALLEL_THRESHOLD;
+}
+
+// The "model name" of the first processor in /proc/cpuinfo, or "unknown".
+int s21_cpu_model(char *model, size_t size) {
+  int flag = CALC_ERROR;
+  snprintf(model, size, "unknown");
+  FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+  char line[512];
+  while (cpuinfo != NULL && flag != OK && fgets(line, sizeof(line), cpuinfo)) {
+    char *colon = strchr(line, ':');
+    if (strncmp(line, "model name", 10) == 0 && colon != NULL) {
+      colon += strspn(colon + 1, " \t") + 1;
+      colon[strcspn(colon, "\n")] = '\0';
+      snprintf(model, size, "%s", colon);
+      flag = OK;
+    }
+  }
+  if (cpuinfo != NULL) fclose(cpuinfo);
+  return flag;
+}
+
+// $S21_TUNING_PROFILE, otherwise ~/.cache/s21_matrix/<cpu model>.profile
+// with every character of the model outside [A-Za-z0-9] replaced by '_'.
+int s21_tuning_path(char *path, size_t size) {
+  int flag = OK;
+  const char *explicit_path = getenv("S21_TUNING_PROFILE");
+  const char *home = getenv("HOME");
+  if (explicit_path != NULL) {
+    snprintf(path, size, "%s", explicit_path);
+  } else if (home == NULL) {
+    flag = CALC_ERROR;
+  } else {
+    char model[256];
+    s21_cpu_model(model, sizeof(model));
+    for (char *c = model; *c != '\0'; c++) {
+      int alnum = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') ||
+                  (*c >= '0' && *c <= '9');
+      if (!alnum) *c = '_';
+    }
+    snprintf(path, size, "%s/.cache/s21_matrix/%s.profile", home, model);
+  }
+  return flag;
+}
+
+static int s21_tuning_field(s21_tuning_t *tuning, const char *key, long value) {
+  int known = 1;
+  if (strcmp(key, "gemm_mc") == 0) {
+    tuning->gemm_mc = (int)value;
+  } else if (strcmp(key, "gemm_kc") == 0) {
+    tuning->gemm_kc = (int)value;
+  } else if (strcmp(key, "gemm_nc") == 0) {
+    tuning->gemm_nc = (int)value;
+  } else if (strcmp(key, "qr_block") == 0) {
+    tuning->qr_block = (int)value;
+  } else if (strcmp(key, "gemv_chunk") == 0) {
+    tuning->gemv_chunk = (int)value;
+  } else if (strcmp(key, "transpose_block") == 0) {
+    tuning->transpose_block = (int)value;
+  } else if (strcmp(key, "parallel_threshold") == 0) {
+    tuning->parallel_threshold = value;
+  } else if (strcmp(key, "elementwise_threshold") == 0) {
+    tuning->elementwise_threshold = value;
+  } else {
+    known = 0;
+  }
+  return known;
+}
+
+// Reads a profile written by s21_tuning_save. The profile is rejected, and
+// tuning left untouched, if it was written on another CPU model or holds a
+// value outside its range.
+int s21_tuning_load(const char *path, s21_tuning_t *tuning) {
+  int flag = OK;
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    s21_tuning_t loaded = *tuning;
+    char line[512], key[64], expected[256];
+    int cpu_matches = 0;
+    s21_cpu_model(expected, sizeof(expected));
+    while (flag == OK && fgets(line, sizeof(line), file)) {
+      long value = 0;
+      if (line[0] == '#' || line[0] == '\n') continue;
+      if (strncmp(line, "cpu ", 4) == 0) {
+        line[strcspn(line, "\n")] = '\0';
+        cpu_matches = strcmp(line + 4, expected) == 0;
+      } else if (sscanf(line, "%63s %ld", key, &value) != 2 || value <= 0 ||
+                 value > (strstr(key, "threshold") ? LONG_MAX : INT_MAX) ||
+                 !s21_tuning_field(&loaded, key, value)) {
+        flag = CALC_ERROR;
+      }
+    }
+    fclose(file);
+    if (flag == OK && cpu_matches) {
+      *tuning = loaded;
+    } else {
+      flag = CALC_ERROR;
+    }
+  }
+  return flag;
+}
+
+int s21_tuning_save(const char *path, const s21_tuning_t *tuning) {
+  int flag = OK;
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    flag = INCORRECT_MATRIX;
+  } else {
+    char model[256];
+    s21_cpu_model(model, sizeof(model));
+    fprintf(file, "# s21_matrix tuning profile\ncpu %s\n", model);
+    fprintf(file, "gemm_mc %d\ngemm_kc %d\ngemm_nc %d\n", tuning->gemm_mc,
+            tuning->gemm_kc, tuning->gemm_nc);
+    fprintf(file, "qr_block %d\ngemv_chunk %d\ntranspose_block %d\n",
+            tuning->qr_block, tuning->gemv_chunk, tuning->transpose_block);
+    fprintf(file, "parallel_threshold %ld\nelementwise_threshold %ld\n",
+            tuning->parallel_threshold, tuning->elementwise_threshold);
+    if (fclose(file) != 0) flag = CALC_ERROR;
+  }
+  return flag;
+}
+
+// Loads the profile of this machine before main(); without one the
+// compiled-in defaults stay, at the cost of a failed fopen.
+__attribute__((constructor)) static void s21_tuning_startup(void) {
+  char path[1024];
+  s21_tuning_t tuning = *s21_tuning_current();
+  if (s21_tuning_path(path, sizeof(path)) == OK &&
+      s21_tuning_load(path, &tuning) == OK) {
+    s21_tuning_publish(&tuning);
+  }
+}
@@ -0,0 +1,157 @@
+#include <future>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_metrics.hpp"
+
+namespace {
+
+using Chain = std::vector<std::reference_wrapper<const S21Matrix>>;
+
+// Cost of one s21_gemm call in flop-equivalents: the multiply-adds, packing of
+// both operands and one pass over the destination.
+double GemmCost(double m, double k, double n) {
+  return 2.0 * m * k * n + m * k + k * n + m * n;
+}
+
+// Sub-products above this cost are worth running on their own thread.
+constexpr double kParallelCost = 1 << 20;
+
+struct ChainPlan {
+  std::vector<int> dims;
+  std::vector<std::vector<double>> cost;
+  std::vector<std::vector<int>> split;
+};
+
+ChainPlan PlanChain(const Chain& chain) {
+  if (chain.empty()) throw std::runtime_error("Incorrect matrix");
+  int count = static_cast<int>(chain.size());
+  ChainPlan plan;
+  plan.dims.push_back(chain[0].get().get_rows());
+  for (int i = 0; i < count; i++) {
+    if (chain[i].get().get_rows() != plan.dims.back())
+      throw std::runtime_error(
+          "The number of columns of the first matrix is not equal to the "
+          "number of rows of the second matrix");
+    plan.dims.push_back(chain[i].get().get_cols());
+  }
+  plan.cost.assign(count, std::vector<double>(count, 0.0));
+  plan.split.assign(count, std::vector<int>(count, 0));
+  for (int length = 2; length <= count; length++) {
+    for (int i = 0; i + length - 1 < count; i++) {
+      int j = i + length - 1;
+      plan.cost[i][j] = std::numeric_limits<double>::infinity();
+      for (int s = i; s < j; s++) {
+        double cost =
+            plan.cost[i][s] + plan.cost[s + 1][j] +
+            GemmCost(plan.dims[i], plan.dims[s + 1], plan.dims[j + 1]);
+        if (cost < plan.cost[i][j]) {
+          plan.cost[i][j] = cost;
+          plan.split[i][j] = s;
+        }
+      }
+    }
+  }
+  return plan;
+}
+
+// Keeps finished intermediates so that later sub-products of the same shape
+// reuse their storage instead of allocating.
+class BufferPool {
+ public:
+  S21Matrix Acquire(int rows, int cols) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+      if (it->get_rows() == rows && it->get_cols() == cols) {
+        S21Matrix buffer(std::move(*it));
+        free_.erase(it);
+        return buffer;
+      }
+    }
+    return S21Matrix(rows, cols);
+  }
+
+  void Release(S21Matrix&& buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(std::move(buffer));
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<S21Matrix> free_;
+};
+
+class ChainRunner {
+ public:
+  ChainRunner(const Chain& chain, const ChainPlan& plan)
+      : chain_(chain), plan_(plan) {}
+
+  S21Matrix Run() { return Product(0, static_cast<int>(chain_.size()) - 1); }
+
+ private:
+  S21Matrix Product(int i, int j) {
+    int s = plan_.split[i][j];
+    std::optional<S21Matrix> left, right;
+    bool left_product = s > i, right_product = j > s + 1;
+    if (left_product && right_product &&
+        plan_.cost[i][s] >= kParallelCost &&
+        plan_.cost[s + 1][j] >= kParallelCost) {
+      auto pending = std::async(std::launch::async, [this, i, s] {
+        S21Metrics::Nested nested;
+        return Product(i, s);
+      });
+      right.emplace(Product(s + 1, j));
+      left.emplace(pending.get());
+    } else {
+      if (left_product) left.emplace(Product(i, s));
+      if (right_product) right.emplace(Product(s + 1, j));
+    }
+    const S21Matrix& a = left ? *left : chain_[i].get();
+    const S21Matrix& b = right ? *right : chain_[j].get();
+    S21Matrix result = pool_.Acquire(plan_.dims[i], plan_.dims[j + 1]);
+    result.Gemm(a, b);
+    if (left) pool_.Release(std::move(*left));
+    if (right) pool_.Release(std::move(*right));
+    return result;
+  }
+
+  const Chain& chain_;
+  const ChainPlan& plan_;
+  BufferPool pool_;
+};
+
+// Multiply-adds and matrix bytes of the products the plan runs for A_i..A_j.
+S21OpCost PlanCost(const ChainPlan& plan, int i, int j) {
+  if (i == j) return S21OpCost{0, 0};
+  int s = plan.split[i][j];
+  S21OpCost left = PlanCost(plan, i, s), right = PlanCost(plan, s + 1, j);
+  double m = plan.dims[i], k = plan.dims[s + 1], n = plan.dims[j + 1];
+  return S21OpCost{left.flops + right.flops + 2.0 * m * k * n,
+                   left.bytes + right.bytes + 8.0 * (m * k + k * n + m * n)};
+}
+
+std::string PlanString(const ChainPlan& plan, int i, int j) {
+  if (i == j) return "A" + std::to_string(i);
+  int s = plan.split[i][j];
+  return "(" + PlanString(plan, i, s) + " " + PlanString(plan, s + 1, j) + ")";
+}
+
+}  // namespace
+
+S21Matrix S21Matrix::MulChain(const Chain& chain) {
+  ChainPlan plan = PlanChain(chain);
+  int last = static_cast<int>(chain.size()) - 1;
+  S21OpScope scope(S21Op::kMulChain, plan.dims.front(), plan.dims.back(),
+                   [&] { return PlanCost(plan, 0, last); });
+  if (chain.size() == 1) return chain[0].get();
+  ChainRunner runner(chain, plan);
+  return runner.Run();
+}
+
+std::string S21Matrix::MulChainOrder(const Chain& chain) {
+  ChainPlan plan = PlanChain(chain);
+  return PlanString(plan, 0, static_cast<int>(chain.size()) - 1);
+}
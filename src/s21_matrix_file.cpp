@@ -0,0 +1,173 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_metrics.hpp"
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kVersion = 1, kFloat64 = 1, kRowMajor = 0;
+constexpr std::uint64_t kAlignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version, dtype, layout, reserved;
+  std::int64_t rows, cols, ld;
+  std::uint64_t offset, checksum;
+};
+
+static_assert(sizeof(FileHeader) == 64, "the header is 64 bytes on disk");
+
+constexpr std::uint64_t kChecksumBasis = 0xcbf29ce484222325ULL;
+
+// FNV-1a over 64-bit words: a word per multiply keeps it near memory speed.
+std::uint64_t Checksum(std::uint64_t hash, const double* data,
+                       std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    std::uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+void CheckLittleEndian() {
+  const std::uint16_t probe = 1;
+  unsigned char first;
+  std::memcpy(&first, &probe, 1);
+  if (first != 1)
+    throw std::runtime_error("Matrix files need a little-endian host");
+}
+
+// Validates the header against a file of size bytes.
+void CheckHeader(const FileHeader& header, std::uint64_t size,
+                 const std::string& path) {
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion)
+    throw std::runtime_error("Not a matrix file: " + path);
+  if (header.dtype != kFloat64 || header.layout != kRowMajor)
+    throw std::runtime_error("Unsupported matrix file: " + path);
+  if (header.rows <= 0 || header.rows > INT_MAX || header.cols <= 0 ||
+      header.cols > INT_MAX || header.ld < header.cols ||
+      header.offset < sizeof(FileHeader) ||
+      header.offset % kAlignment != 0 ||
+      static_cast<std::uint64_t>(header.ld) >
+          (UINT64_MAX - header.offset) / sizeof(double) /
+              static_cast<std::uint64_t>(header.rows) ||
+      header.offset + sizeof(double) * header.rows * header.ld > size)
+    throw std::runtime_error("Corrupted matrix file: " + path);
+}
+
+}  // namespace
+
+void S21Matrix::Save(const std::string& path) const {
+  CheckLittleEndian();
+  S21OpScope scope(S21Op::kSave, rows_, cols_, 0, 8.0 * rows_ * cols_);
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dtype = kFloat64;
+  header.layout = kRowMajor;
+  header.rows = rows_;
+  header.cols = cols_;
+  header.ld = cols_;
+  header.offset = kAlignment;
+  header.checksum = kChecksumBasis;
+  for (int i = 0; i < rows_; i++)
+    header.checksum = Checksum(header.checksum, matrix_->matrix[i], cols_);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  char padding[kAlignment] = {};
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(padding, kAlignment - sizeof(header));
+  for (int i = 0; i < rows_ && file; i++) {
+    file.write(reinterpret_cast<const char*>(matrix_->matrix[i]),
+               sizeof(double) * cols_);
+  }
+  file.close();
+  if (!file) throw std::runtime_error("Cannot write " + path);
+}
+
+S21Matrix S21Matrix::Load(const std::string& path) {
+  CheckLittleEndian();
+  S21OpScope scope(S21Op::kLoad, 0, 0, 0, 0);
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) throw std::runtime_error("Cannot read " + path);
+  std::uint64_t size = static_cast<std::uint64_t>(file.tellg());
+  FileHeader header{};
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file) throw std::runtime_error("Not a matrix file: " + path);
+  CheckHeader(header, size, path);
+  int rows = static_cast<int>(header.rows);
+  int cols = static_cast<int>(header.cols);
+  scope.Result(rows, cols, 8.0 * header.rows * header.ld);
+  S21Matrix result(rows, cols);
+  std::uint64_t checksum = kChecksumBasis;
+  file.seekg(static_cast<std::streamoff>(header.offset));
+  if (header.ld == header.cols) {
+    // One read straight into the contiguous storage.
+    double* data = result.matrix_->matrix[0];
+    file.read(reinterpret_cast<char*>(data),
+              static_cast<std::streamsize>(sizeof(double) * rows * cols));
+    checksum = Checksum(checksum, data, static_cast<std::size_t>(rows) * cols);
+  } else {
+    std::vector<double> row(static_cast<std::size_t>(header.ld));
+    for (int i = 0; i < rows && file; i++) {
+      file.read(reinterpret_cast<char*>(row.data()),
+                static_cast<std::streamsize>(sizeof(double) * row.size()));
+      checksum = Checksum(checksum, row.data(), row.size());
+      std::memcpy(result.matrix_->matrix[i], row.data(), sizeof(double) * cols);
+    }
+  }
+  if (!file) throw std::runtime_error("Cannot read " + path);
+  if (checksum != header.checksum)
+    throw std::runtime_error("Checksum mismatch in " + path);
+  return result;
+}
+
+S21Matrix S21Matrix::Map(const std::string& path, S21MapMode mode,
+                         bool verify) {
+  CheckLittleEndian();
+  S21OpScope scope(S21Op::kMap, 0, 0, 0, 0);
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Cannot read " + path);
+  struct stat info;
+  void* address = MAP_FAILED;
+  std::uint64_t size = 0;
+  if (fstat(fd, &info) == 0 &&
+      info.st_size >= static_cast<off_t>(sizeof(FileHeader))) {
+    size = static_cast<std::uint64_t>(info.st_size);
+    bool private_copy = mode == S21MapMode::kCopyOnWrite;
+    address = mmap(nullptr, size, PROT_READ | (private_copy ? PROT_WRITE : 0),
+                   private_copy ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (address == MAP_FAILED) throw std::runtime_error("Cannot map " + path);
+  std::shared_ptr<void> mapping(
+      address, [size](void* pointer) { munmap(pointer, size); });
+  FileHeader header;
+  std::memcpy(&header, address, sizeof(header));
+  CheckHeader(header, size, path);
+  scope.Result(static_cast<int>(header.rows), static_cast<int>(header.cols),
+               verify ? 8.0 * header.rows * header.ld : 0);
+  double* data = reinterpret_cast<double*>(static_cast<char*>(address) +
+                                           header.offset);
+  if (verify &&
+      Checksum(kChecksumBasis, data,
+               static_cast<std::size_t>(header.rows * header.ld)) !=
+          header.checksum)
+    throw std::runtime_error("Checksum mismatch in " + path);
+  S21Matrix result(data, static_cast<int>(header.rows),
+                   static_cast<int>(header.cols), header.ld,
+                   [mapping](double*) {});
+  result.read_only_ = mode == S21MapMode::kReadOnly;
+  return result;
+}
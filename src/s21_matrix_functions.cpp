@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cmath>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_metrics.hpp"
+
+namespace {
+
+// Largest 1-norms for which the [m/m] Pade approximant of exp reaches double
+// precision (Higham, 2005).
+constexpr double kTheta3 = 1.495585217958292e-2;
+constexpr double kTheta5 = 2.539398330063230e-1;
+constexpr double kTheta7 = 9.504178996162932e-1;
+constexpr double kTheta9 = 2.097847961257068;
+constexpr double kTheta13 = 5.371920351148152;
+
+const double kPade3[] = {120, 60, 12, 1};
+const double kPade5[] = {30240, 15120, 3360, 420, 30, 1};
+const double kPade7[] = {17297280, 8648640, 1995840, 277200,
+                         25200,    1512,    56,      1};
+const double kPade9[] = {17643225600., 8821612800., 2075673600., 302702400.,
+                         30270240.,    2162160.,    110880.,     3960.,
+                         90.,          1.};
+const double kPade13[] = {64764752532480000., 32382376266240000.,
+                          7771770303897600.,  1187353796428800.,
+                          129060195264000.,   10559470521600.,
+                          670442572800.,      33522128640.,
+                          1323241920.,        40840800.,
+                          960960.,            16380.,
+                          182.,               1.};
+
+void AddIdentity(matrix_t* matrix, double value) {
+  for (int i = 0; i < matrix->rows; i++) matrix->matrix[i][i] += value;
+}
+
+}  // namespace
+
+void S21Workspace::Prepare(std::size_t count, int rows, int cols) {
+  if (buffers_.size() < count) buffers_.resize(count);
+  for (std::size_t i = 0; i < count; i++) {
+    if (buffers_[i].get_rows() != rows || buffers_[i].get_cols() != cols) {
+      buffers_[i] = S21Matrix(rows, cols);
+    }
+    buffers_[i].Detach();
+  }
+  if (pivots_.size() < static_cast<std::size_t>(rows)) pivots_.resize(rows);
+}
+
+void S21Workspace::Deliver(std::size_t index, S21Matrix& result) {
+  if (result.storage_ && !result.shared_) {
+    s21_axpby_matrix(1.0, buffers_[index].matrix_, 0.0, result.matrix_);
+  } else {
+    std::swap(result, buffers_[index]);
+  }
+}
+
+S21Matrix S21Matrix::Expm() const {
+  S21Matrix result(rows_, cols_);
+  S21Workspace workspace;
+  Expm(result, workspace);
+  return result;
+}
+
+// Scaling and squaring with Pade approximants of degree 3 to 13.
+void S21Matrix::Expm(S21Matrix& result, S21Workspace& workspace) const {
+  if (rows_ != cols_) throw std::runtime_error("The matrix is not square");
+  // Counted as the eight products of the degree 13 approximant.
+  S21OpScope scope(S21Op::kExpm, rows_, cols_, 16.0 * rows_ * rows_ * cols_,
+                   8.0 * 24 * rows_ * cols_);
+  if (result.rows_ != rows_ || result.cols_ != cols_) {
+    result = S21Matrix(rows_, cols_);
+  }
+  result.Detach();
+  double norm = 0;
+  for (int j = 0; j < cols_; j++) {
+    double column = 0;
+    for (int i = 0; i < rows_; i++) column += std::fabs(matrix_->matrix[i][j]);
+    norm = std::fmax(norm, column);
+  }
+  int squarings = 0;
+  int degree = 13;
+  const double* b = kPade13;
+  if (norm <= kTheta3) {
+    degree = 3;
+    b = kPade3;
+  } else if (norm <= kTheta5) {
+    degree = 5;
+    b = kPade5;
+  } else if (norm <= kTheta7) {
+    degree = 7;
+    b = kPade7;
+  } else if (norm <= kTheta9) {
+    degree = 9;
+    b = kPade9;
+  } else {
+    squarings = std::max(0, static_cast<int>(std::ceil(
+                                std::log2(norm / kTheta13))));
+  }
+  workspace.Prepare(7, rows_, cols_);
+  std::vector<S21Matrix>& w = workspace.buffers_;
+  matrix_t* a = w[0].matrix_;
+  matrix_t* a2 = w[1].matrix_;
+  matrix_t* a4 = w[2].matrix_;
+  matrix_t* a6 = w[3].matrix_;
+  matrix_t* u = w[4].matrix_;
+  matrix_t* v = w[5].matrix_;
+  matrix_t* t = w[6].matrix_;
+  s21_axpby_matrix(std::ldexp(1.0, -squarings), matrix_, 0.0, a);
+  S21Memory::Check(s21_gemm(0, 0, 1.0, a, a, 0.0, a2));
+  if (degree >= 5) S21Memory::Check(s21_gemm(0, 0, 1.0, a2, a2, 0.0, a4));
+  if (degree >= 7) S21Memory::Check(s21_gemm(0, 0, 1.0, a4, a2, 0.0, a6));
+  if (degree == 13) {
+    s21_axpby_matrix(b[13], a6, 0.0, t);
+    s21_axpby_matrix(b[11], a4, 1.0, t);
+    s21_axpby_matrix(b[9], a2, 1.0, t);
+    S21Memory::Check(s21_gemm(0, 0, 1.0, a6, t, 0.0, u));
+    s21_axpby_matrix(b[7], a6, 1.0, u);
+    s21_axpby_matrix(b[5], a4, 1.0, u);
+    s21_axpby_matrix(b[3], a2, 1.0, u);
+    AddIdentity(u, b[1]);
+    s21_axpby_matrix(b[12], a6, 0.0, t);
+    s21_axpby_matrix(b[10], a4, 1.0, t);
+    s21_axpby_matrix(b[8], a2, 1.0, t);
+    S21Memory::Check(s21_gemm(0, 0, 1.0, a6, t, 0.0, v));
+    s21_axpby_matrix(b[6], a6, 1.0, v);
+    s21_axpby_matrix(b[4], a4, 1.0, v);
+    s21_axpby_matrix(b[2], a2, 1.0, v);
+    AddIdentity(v, b[0]);
+  } else {
+    s21_axpby_matrix(b[3], a2, 0.0, u);
+    s21_axpby_matrix(b[2], a2, 0.0, v);
+    AddIdentity(u, b[1]);
+    AddIdentity(v, b[0]);
+    if (degree >= 5) {
+      s21_axpby_matrix(b[5], a4, 1.0, u);
+      s21_axpby_matrix(b[4], a4, 1.0, v);
+    }
+    if (degree >= 7) {
+      s21_axpby_matrix(b[7], a6, 1.0, u);
+      s21_axpby_matrix(b[6], a6, 1.0, v);
+    }
+    if (degree >= 9) {
+      S21Memory::Check(s21_gemm(0, 0, 1.0, a4, a4, 0.0, t));
+      s21_axpby_matrix(b[9], t, 1.0, u);
+      s21_axpby_matrix(b[8], t, 1.0, v);
+    }
+  }
+  S21Memory::Check(s21_gemm(0, 0, 1.0, a, u, 0.0, t));
+  // exp(A) ~ (V - U)^-1 (V + U), solved through the LU of V - U.
+  s21_axpby_matrix(1.0, v, 0.0, u);
+  s21_axpby_matrix(1.0, t, 1.0, u);
+  s21_axpby_matrix(-1.0, t, 1.0, v);
+  int sign = 1;
+  if (s21_lu_decomposition(v, workspace.pivots_.data(), &sign) != 0)
+    throw std::runtime_error("Matrix determinant is 0");
+  s21_lu_solve(v, workspace.pivots_.data(), u);
+  for (int i = 0; i < squarings; i++) {
+    S21Memory::Check(s21_gemm(0, 0, 1.0, u, u, 0.0, t));
+    std::swap(w[4], w[6]);
+    u = w[4].matrix_;
+    t = w[6].matrix_;
+  }
+  workspace.Deliver(4, result);
+}
+
+S21Matrix S21Matrix::Polynomial(const std::vector<double>& coefficients) const {
+  S21Matrix result(rows_, cols_);
+  S21Workspace workspace;
+  Polynomial(coefficients, result, workspace);
+  return result;
+}
+
+// Paterson-Stockmeyer: with s = ceil(sqrt(d + 1)) the powers A^2..A^s are
+// formed once and p(A) is evaluated as a Horner scheme in A^s whose
+// coefficients are degree s - 1 blocks, about 2 sqrt(d) products in total.
+void S21Matrix::Polynomial(const std::vector<double>& coefficients,
+                           S21Matrix& result, S21Workspace& workspace) const {
+  if (rows_ != cols_) throw std::runtime_error("The matrix is not square");
+  int degree = static_cast<int>(coefficients.size()) - 1;
+  int step = std::max(1, static_cast<int>(std::ceil(std::sqrt(degree + 1.0))));
+  int blocks = degree < 0 ? 0 : degree / step;
+  // step - 1 products for the powers and one per Horner block.
+  S21OpScope scope(S21Op::kPolynomial, rows_, cols_,
+                   2.0 * (step - 1 + blocks) * rows_ * rows_ * cols_,
+                   8.0 * (step + 3) * rows_ * cols_);
+  if (result.rows_ != rows_ || result.cols_ != cols_) {
+    result = S21Matrix(rows_, cols_);
+  }
+  result.Detach();
+  workspace.Prepare(step + 1, rows_, cols_);
+  std::vector<S21Matrix>& w = workspace.buffers_;
+  // w[j] holds A^j for 2 <= j <= step, w[0] and w[1] are the Horner buffers.
+  auto power = [&](int j) { return j == 1 ? matrix_ : w[j].matrix_; };
+  for (int j = 2; j <= step; j++) {
+    S21Memory::Check(
+        s21_gemm(0, 0, 1.0, power(j - 1), matrix_, 0.0, w[j].matrix_));
+  }
+  auto add_block = [&](int block, matrix_t* target) {
+    for (int j = 1; j < step && block * step + j <= degree; j++) {
+      s21_axpby_matrix(coefficients[block * step + j], power(j), 1.0, target);
+    }
+    AddIdentity(target, coefficients[block * step]);
+  };
+  s21_axpby_matrix(0.0, matrix_, 0.0, w[0].matrix_);
+  if (degree >= 0) add_block(blocks, w[0].matrix_);
+  for (int block = blocks - 1; block >= 0; block--) {
+    S21Memory::Check(
+        s21_gemm(0, 0, 1.0, w[0].matrix_, power(step), 0.0, w[1].matrix_));
+    add_block(block, w[1].matrix_);
+    std::swap(w[0], w[1]);
+  }
+  workspace.Deliver(0, result);
+}
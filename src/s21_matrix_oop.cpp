@@ -1,106 +1,477 @@
 #include "s21_matrix_oop.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "s21_metrics.hpp"
+
+namespace {
+
+// Multiplications of a cofactor expansion of order size, the cost model for
+// Determinant, CalcComplements and InverseMatrix.
+double CofactorFlops(int size) {
+  double flops = 1;
+  for (int i = 2; i <= size; i++) flops *= i;
+  return flops;
+}
+
+// Storage of a rows x cols matrix; throws without leaving anything
+// allocated.
+matrix_t* CreateMatrix(int rows, int cols) {
+  matrix_t* matrix = new matrix_t{};
+  int error = s21_create_matrix(rows, cols, matrix);
+  if (error != OK) delete matrix;
+  if (error == INCORRECT_MATRIX) throw std::runtime_error("Incorrect matrix");
+  if (error == MEMORY_ERROR)
+    throw S21MemoryError("Cannot allocate a " + std::to_string(rows) + "x" +
+                         std::to_string(cols) + " matrix");
+  return matrix;
+}
+
+std::atomic<bool> copy_on_write{false};
+
+// A matrix of s21_create_matrix owned jointly by copy-on-write copies.
+class SharedMatrix {
+ public:
+  explicit SharedMatrix(matrix_t* matrix) : matrix_(matrix) {}
+  SharedMatrix(const SharedMatrix&) = delete;
+  SharedMatrix& operator=(const SharedMatrix&) = delete;
+  ~SharedMatrix() {
+    s21_remove_matrix(matrix_);
+    delete matrix_;
+  }
+
+ private:
+  matrix_t* matrix_;
+};
+
+}  // namespace
+
 S21Matrix::S21Matrix() : matrix_(nullptr), rows_(1), cols_(1) {
-  matrix_ = new matrix_t;
-  s21_create_matrix(rows_, cols_, this->matrix_);
+  S21Metrics::CountAllocation();
+  matrix_ = CreateMatrix(rows_, cols_);
+  Share();
 }
 
 S21Matrix::S21Matrix(int rows, int cols)
     : matrix_(nullptr), rows_(rows), cols_(cols) {
-  matrix_ = new matrix_t;
-  int error = s21_create_matrix(rows_, cols_, this->matrix_);
-  if (error == 1) throw std::runtime_error("Incorrect matrix");
+  S21Metrics::CountAllocation();
+  matrix_ = CreateMatrix(rows_, cols_);
+  Share();
 }
 
 S21Matrix::S21Matrix(const S21Matrix& other)
     : matrix_(nullptr), rows_(other.rows_), cols_(other.cols_) {
-  matrix_ = new matrix_t;
-  s21_create_matrix(other.rows_, other.cols_, this->matrix_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_->matrix[i][j] = other.matrix_->matrix[i][j];
+  if (CopyOnWrite() && other.shared_ && !other.unshareable_) {
+    matrix_ = other.matrix_;
+    storage_ = other.storage_;
+    shared_ = true;
+  } else {
+    S21Metrics::CountAllocation();
+    matrix_ = CreateMatrix(other.rows_, other.cols_);
+    for (int i = 0; i < rows_; i++) {
+      for (int j = 0; j < cols_; j++) {
+        matrix_->matrix[i][j] = other.matrix_->matrix[i][j];
+      }
     }
+    Share();
   }
 }
 
 S21Matrix::S21Matrix(S21Matrix&& other) noexcept
-    : matrix_(other.matrix_), rows_(other.rows_), cols_(other.cols_) {
+    : matrix_(other.matrix_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      storage_(std::move(other.storage_)),
+      read_only_(other.read_only_),
+      shared_(other.shared_),
+      unshareable_(other.unshareable_) {
+  other.read_only_ = false;
+  other.shared_ = false;
+  other.unshareable_ = false;
   other.matrix_ =
       nullptr;  // Обеспечиваем, что деструктор `other` не освободит память
   other.rows_ = 0;
   other.cols_ = 0;
 }
 
-S21Matrix::~S21Matrix() {
-  if (this->matrix_ != nullptr) {
-    s21_remove_matrix(this->matrix_);  // Вызываем функцию удаления только если
-                                       // указатель валиден
-    delete this->matrix_;  // Удаляем объект matrix_t
-    this->matrix_ = nullptr;  // Обеспечиваем, что указатель нулевой
+S21Matrix::S21Matrix(double* data, int rows, int cols, long ld,
+                     std::function<void(double*)> deleter)
+    : matrix_(nullptr), rows_(rows), cols_(cols) {
+  matrix_t view{};
+  int error = s21_wrap_matrix(data, rows, cols, ld > 0 ? ld : cols, &view);
+  if (error == INCORRECT_MATRIX) throw std::runtime_error("Incorrect matrix");
+  S21Memory::Check(error);
+  try {
+    matrix_ = new matrix_t(view);
+    if (deleter) {
+      storage_.reset(data, [deleter](void* elements) {
+        deleter(static_cast<double*>(elements));
+      });
+    } else {
+      storage_.reset(data, [](void*) {});
+    }
+  } catch (...) {
+    s21_remove_submatrix(&view);
+    delete matrix_;
+    throw;
   }
+}
+
+S21Matrix::S21Matrix(const double* data, int rows, int cols, long ld)
+    : S21Matrix(const_cast<double*>(data), rows, cols, ld) {
+  read_only_ = true;
+}
+
+S21Matrix::~S21Matrix() {
+  Release();
   this->rows_ = 0;
   this->cols_ = 0;
 }
 
+void S21Matrix::Release() {
+  // Общую матрицу освобождает последний владелец storage_
+  if (this->matrix_ != nullptr && !shared_) {
+    // Чужие элементы освобождает владелец storage_, здесь только строки
+    if (storage_) {
+      s21_remove_submatrix(this->matrix_);
+    } else {
+      s21_remove_matrix(this->matrix_);
+    }
+    delete this->matrix_;  // Удаляем объект matrix_t
+  }
+  this->matrix_ = nullptr;  // Обеспечиваем, что указатель нулевой
+  storage_.reset();
+  read_only_ = false;
+  shared_ = false;
+  unshareable_ = false;
+}
+
+void S21Matrix::SetCopyOnWrite(bool enabled) { copy_on_write = enabled; }
+
+bool S21Matrix::CopyOnWrite() { return copy_on_write; }
+
+// Only in copy-on-write mode. Without memory for the owner the matrix
+// stays unshared and its copies are deep.
+void S21Matrix::Share() {
+  if (CopyOnWrite() && !storage_) {
+    try {
+      storage_ = std::make_shared<SharedMatrix>(matrix_);
+      shared_ = true;
+    } catch (const std::bad_alloc&) {
+    }
+  }
+}
+
+void S21Matrix::Detach() {
+  bool shared = shared_ && storage_.use_count() > 1;
+  // Orders the writes after the reads of the copies released meanwhile.
+  if (shared_) std::atomic_thread_fence(std::memory_order_acquire);
+  if (read_only_ || shared) {
+    S21Matrix copy(rows_, cols_);
+    for (int i = 0; i < rows_; i++) {
+      for (int j = 0; j < cols_; j++) {
+        copy.matrix_->matrix[i][j] = matrix_->matrix[i][j];
+      }
+    }
+    *this = std::move(copy);
+  }
+}
+
 bool S21Matrix::EqMatrix(const S21Matrix& other) const {
+  S21OpScope scope(S21Op::kEqMatrix, rows_, cols_, 1.0 * rows_ * cols_,
+                   16.0 * rows_ * cols_);
   return s21_eq_matrix(other.matrix_, matrix_);
 }
 
 void S21Matrix::SumMatrix(const S21Matrix& other) {
-  int error = s21_sum_matrix(matrix_, other.matrix_, this->matrix_);
+  S21OpScope scope(S21Op::kSumMatrix, rows_, cols_, 1.0 * rows_ * cols_,
+                   24.0 * rows_ * cols_);
+  scope.Algorithm(s21_backend_current()->name);
+  Detach();
+  int error = s21_backend_current()->axpby(1.0, other.matrix_, 1.0, matrix_);
   if (error == 2) throw std::runtime_error("Different matrix dimensions");
 }
 
 void S21Matrix::SubMatrix(const S21Matrix& other) {
-  int error = s21_sub_matrix(matrix_, other.matrix_, this->matrix_);
+  S21OpScope scope(S21Op::kSubMatrix, rows_, cols_, 1.0 * rows_ * cols_,
+                   24.0 * rows_ * cols_);
+  scope.Algorithm(s21_backend_current()->name);
+  Detach();
+  int error = s21_backend_current()->axpby(-1.0, other.matrix_, 1.0, matrix_);
   if (error == 2) throw std::runtime_error("Different matrix dimensions");
 }
 
 void S21Matrix::MulNumber(const double num) {
-  int error = s21_mult_number(matrix_, num, this->matrix_);
+  S21OpScope scope(S21Op::kMulNumber, rows_, cols_, 1.0 * rows_ * cols_,
+                   16.0 * rows_ * cols_);
+  scope.Algorithm(s21_backend_current()->name);
+  Detach();
+  int error = s21_backend_current()->axpby(num, matrix_, 0.0, matrix_);
   if (error == 1) throw std::runtime_error("Incorrect matrix");
 }
 
 void S21Matrix::MulMatrix(const S21Matrix& other) {
-  S21Matrix matrix_temp(*this);
-  S21Matrix matrix_temp2(other);
-  int error =
-      s21_mult_matrix(matrix_temp.matrix_, matrix_temp2.matrix_, this->matrix_);
-  matrix_temp.~S21Matrix();
-  matrix_temp2.~S21Matrix();
-  if (error == 2)
+  if (cols_ != other.rows_)
     throw std::runtime_error(
         "The number of columns of the first matrix is not equal to the number "
         "of rows of the second matrix");
+  S21OpScope scope(S21Op::kMulMatrix, rows_, other.cols_,
+                   2.0 * rows_ * cols_ * other.cols_,
+                   8.0 * rows_ * cols_ + 8.0 * other.rows_ * other.cols_ +
+                       8.0 * rows_ * other.cols_);
+  scope.Algorithm(s21_backend_current()->name);
+  S21Matrix result(rows_, other.cols_);
+  S21Memory::Check(s21_backend_current()->gemm(0, 0, 1.0, matrix_,
+                                               other.matrix_, 0.0,
+                                               result.matrix_));
+  *this = std::move(result);
+}
+
+void S21Matrix::Gemm(const S21Matrix& a, const S21Matrix& b, double alpha,
+                     double beta, bool transpose_a, bool transpose_b) {
+  int inner = transpose_a ? a.rows_ : a.cols_;
+  if ((transpose_a ? a.cols_ : a.rows_) != rows_ ||
+      (transpose_b ? b.cols_ : b.rows_) != inner ||
+      (transpose_b ? b.rows_ : b.cols_) != cols_)
+    throw std::runtime_error("Different matrix dimensions");
+  S21OpScope scope(S21Op::kGemm, rows_, cols_, 2.0 * rows_ * cols_ * inner,
+                   8.0 * a.rows_ * a.cols_ + 8.0 * b.rows_ * b.cols_ +
+                       16.0 * rows_ * cols_);
+  if (&a == this || &b == this) {
+    // One copy of the output serves both operands if both alias it.
+    S21Matrix copy(*this);
+    Gemm(&a == this ? copy : a, &b == this ? copy : b, alpha, beta,
+         transpose_a, transpose_b);
+  } else {
+    scope.Algorithm(s21_backend_current()->name);
+    Detach();
+    int error = s21_backend_current()->gemm(transpose_a, transpose_b, alpha,
+                                            a.matrix_, b.matrix_, beta,
+                                            matrix_);
+    if (error == 2) throw std::runtime_error("Different matrix dimensions");
+    S21Memory::Check(error);
+  }
+}
+
+S21Matrix S21Matrix::Syrk(bool transpose) const {
+  int size = transpose ? cols_ : rows_;
+  // One triangle of the size x size product: half the flops of MulMatrix.
+  S21OpScope scope(S21Op::kSyrk, size, size,
+                   1.0 * size * size * (transpose ? rows_ : cols_),
+                   8.0 * rows_ * cols_ + 8.0 * size * size);
+  S21Matrix result(size, size);
+  int error = s21_syrk_lower(transpose, 1.0, matrix_, 0.0, result.matrix_);
+  if (error == 1) throw std::runtime_error("Incorrect matrix");
+  S21Memory::Check(error);
+  s21_mirror_lower(result.matrix_);
+  return result;
 }
 
 S21Matrix S21Matrix::Transpose() const {
+  S21OpScope scope(S21Op::kTranspose, cols_, rows_, 0, 16.0 * rows_ * cols_);
+  scope.Algorithm(s21_backend_current()->name);
   S21Matrix result(cols_, rows_);
-  s21_transpose(this->matrix_, result.matrix_);
+  s21_backend_current()->transpose(this->matrix_, result.matrix_);
   return result;
 }
 
 S21Matrix S21Matrix::CalcComplements() const {
+  if (rows_ != cols_) throw std::runtime_error("The matrix is not square");
+  S21OpScope scope(S21Op::kCalcComplements, rows_, cols_, [&] {
+    return S21OpCost{1.0 * rows_ * cols_ * CofactorFlops(rows_ - 1),
+                     16.0 * rows_ * cols_};
+  });
   S21Matrix result(rows_, cols_);
-  int error = s21_calc_complements(this->matrix_, result.matrix_);
-  if (error == 2) throw std::runtime_error("The matrix is not square");
+  scope.Algorithm("cofactor");
+  s21_calc_complements(this->matrix_, result.matrix_);
   return result;
 }
 
 double S21Matrix::Determinant() const {
+  if (rows_ != cols_) throw std::runtime_error("The matrix is not square");
+  S21OpScope scope(S21Op::kDeterminant, rows_, cols_, [&] {
+    return S21OpCost{CofactorFlops(rows_), 8.0 * rows_ * cols_};
+  });
   double result = 0;
-  int error = s21_determinant(this->matrix_, &result);
-  if (error == 2) throw std::runtime_error("The matrix is not square");
+  scope.Algorithm("cofactor");
+  s21_determinant(this->matrix_, &result);
   return result;
 }
 
 S21Matrix S21Matrix::InverseMatrix() const {
+  if (rows_ != cols_) throw std::runtime_error("The matrix is not square");
+  S21OpScope scope(S21Op::kInverseMatrix, rows_, cols_, [&] {
+    return S21OpCost{(1.0 * rows_ * cols_ + 1.0) * CofactorFlops(rows_ - 1),
+                     16.0 * rows_ * cols_};
+  });
   S21Matrix result(rows_, cols_);
+  scope.Algorithm("cofactor");
   int error = s21_inverse_matrix(this->matrix_, result.matrix_);
   if (error == 2) throw std::runtime_error("Matrix determinant is 0");
   return result;
 }
 
+void S21Matrix::QrDecomposition(S21Matrix& q, S21Matrix& r) const {
+  int k = rows_ < cols_ ? rows_ : cols_;
+  S21OpScope scope(S21Op::kQrDecomposition, rows_, cols_,
+                   4.0 * rows_ * cols_ * k - 4.0 / 3.0 * k * k * k,
+                   16.0 * rows_ * cols_ + 8.0 * rows_ * k);
+  S21Matrix qr(*this);
+  qr.Detach();
+  scope.Algorithm(s21_backend_current()->name);
+  std::vector<double> tau(k);
+  int error = s21_backend_current()->qr_decomposition(qr.matrix_, tau.data());
+  S21Memory::Check(error);
+  if (error != OK) throw std::runtime_error("The QR decomposition failed");
+  S21Matrix thin_q(rows_, k);
+  for (int i = 0; i < k; i++) thin_q.matrix_->matrix[i][i] = 1.0;
+  S21Memory::Check(s21_qr_apply(qr.matrix_, tau.data(), 0, thin_q.matrix_));
+  S21Matrix upper(k, cols_);
+  for (int i = 0; i < k; i++) {
+    for (int j = i; j < cols_; j++) {
+      upper.matrix_->matrix[i][j] = qr.matrix_->matrix[i][j];
+    }
+  }
+  q = thin_q;
+  r = upper;
+}
+
+S21Matrix S21Matrix::Cholesky() const {
+  if (rows_ != cols_) throw std::runtime_error("The matrix is not square");
+  S21OpScope scope(S21Op::kCholesky, rows_, cols_,
+                   1.0 / 3.0 * rows_ * rows_ * rows_, 16.0 * rows_ * cols_);
+  scope.Algorithm(s21_backend_current()->name);
+  S21Matrix result(*this);
+  result.Detach();
+  int error = s21_backend_current()->cholesky(result.matrix_);
+  if (error == 2)
+    throw std::runtime_error("The matrix is not positive definite");
+  return result;
+}
+
+S21Matrix S21Matrix::SolveLeastSquares(const S21Matrix& b) const {
+  if (rows_ < cols_) throw std::runtime_error("The matrix is not tall");
+  if (rows_ != b.rows_) throw std::runtime_error("Different matrix dimensions");
+  S21OpScope scope(S21Op::kSolveLeastSquares, rows_, cols_,
+                   2.0 * cols_ * cols_ * (rows_ - cols_ / 3.0) +
+                       4.0 * rows_ * cols_ * b.cols_,
+                   8.0 * rows_ * cols_ + 8.0 * rows_ * b.cols_ +
+                       8.0 * cols_ * b.cols_);
+  S21Matrix result(cols_, b.cols_);
+  int error = s21_least_squares(matrix_, b.matrix_, result.matrix_);
+  if (error == 2) throw std::runtime_error("The matrix is rank deficient");
+  S21Memory::Check(error);
+  return result;
+}
+
+void S21Matrix::Gemv(double alpha, const std::vector<double>& x, double beta,
+                     std::vector<double>& y, bool transpose) const {
+  std::size_t x_size = transpose ? rows_ : cols_;
+  std::size_t y_size = transpose ? cols_ : rows_;
+  if (x.size() != x_size || y.size() != y_size)
+    throw std::runtime_error("Different matrix dimensions");
+  S21OpScope scope(S21Op::kGemv, rows_, cols_, 2.0 * rows_ * cols_,
+                   8.0 * rows_ * cols_ + 8.0 * x_size + 16.0 * y_size);
+  s21_gemv(transpose, alpha, matrix_, x.data(), beta, y.data());
+}
+
+void S21Matrix::Ger(double alpha, const std::vector<double>& x,
+                    const std::vector<double>& y) {
+  if (x.size() != static_cast<std::size_t>(rows_) ||
+      y.size() != static_cast<std::size_t>(cols_))
+    throw std::runtime_error("Different matrix dimensions");
+  S21OpScope scope(S21Op::kGer, rows_, cols_, 2.0 * rows_ * cols_,
+                   16.0 * rows_ * cols_ + 8.0 * rows_ + 8.0 * cols_);
+  Detach();
+  s21_ger(alpha, x.data(), y.data(), matrix_);
+}
+
+S21Matrix S21Matrix::Pow(int power) const {
+  if (rows_ != cols_) throw std::runtime_error("The matrix is not square");
+  S21OpScope scope(S21Op::kPow, rows_, cols_, [&] {
+    double products = 2.0 * std::log2(std::fabs(1.0 * power) + 1.0);
+    return S21OpCost{2.0 * rows_ * rows_ * cols_ * products,
+                     24.0 * rows_ * cols_ * products};
+  });
+  int kind = s21_triangular_kind(matrix_);
+  scope.Algorithm(kind == S21_DIAGONAL           ? "diagonal"
+                  : kind == S21_UPPER_TRIANGULAR ||
+                          kind == S21_LOWER_TRIANGULAR
+                      ? "triangular"
+                      : "gemm");
+  long long exponent = power;
+  S21Matrix result(rows_, cols_);
+  if (kind == S21_DIAGONAL) {
+    for (int i = 0; i < rows_; i++) {
+      double element = matrix_->matrix[i][i];
+      if (element == 0 && exponent < 0)
+        throw std::runtime_error("Matrix determinant is 0");
+      result.matrix_->matrix[i][i] = std::pow(element, exponent);
+    }
+    return result;
+  }
+  // Binary exponentiation over three fixed buffers: result, base and the
+  // product scratch, swapped instead of reallocated after every multiply.
+  // Near the memory budget a positive power walks its bits from the top
+  // instead, squaring result and multiplying by *this, which needs no base
+  // and still takes at most two products per bit.
+  S21Matrix scratch(rows_, cols_);
+  auto multiply = [&](S21Matrix& left, const S21Matrix& right) {
+    if (kind == S21_UPPER_TRIANGULAR || kind == S21_LOWER_TRIANGULAR) {
+      s21_triangular_mult(kind == S21_UPPER_TRIANGULAR, left.matrix_,
+                          right.matrix_, scratch.matrix_);
+    } else {
+      S21Memory::Check(s21_gemm(0, 0, 1.0, left.matrix_, right.matrix_, 0.0,
+                                scratch.matrix_));
+    }
+    std::swap(left, scratch);
+  };
+  if (exponent > 0 && !S21Memory::Fits(8.0 * rows_ * cols_)) {
+    scope.Algorithm("top-down");
+    s21_mult_number(matrix_, 1.0, result.matrix_);
+    int bit = 62;
+    while (!(exponent >> bit & 1)) bit--;
+    for (bit--; bit >= 0; bit--) {
+      multiply(result, result);
+      if (exponent >> bit & 1) multiply(result, *this);
+    }
+    return result;
+  }
+  S21Matrix base(rows_, cols_);
+  for (int i = 0; i < rows_; i++) base.matrix_->matrix[i][i] = 1.0;
+  if (exponent < 0) {
+    S21Matrix lu(*this);
+    lu.Detach();
+    std::vector<int> pivots(rows_);
+    int sign = 1;
+    if (s21_backend_current()->lu_decomposition(lu.matrix_, pivots.data(),
+                                                &sign) != 0)
+      throw std::runtime_error("Matrix determinant is 0");
+    s21_lu_solve(lu.matrix_, pivots.data(), base.matrix_);
+    exponent = -exponent;
+  } else {
+    s21_mult_number(matrix_, 1.0, base.matrix_);
+  }
+  bool started = false;
+  for (; exponent > 0; exponent >>= 1) {
+    if (exponent & 1) {
+      if (started) {
+        multiply(result, base);
+      } else {
+        s21_mult_number(base.matrix_, 1.0, result.matrix_);
+        started = true;
+      }
+    }
+    if (exponent > 1) multiply(base, base);
+  }
+  if (!started) {
+    for (int i = 0; i < rows_; i++) result.matrix_->matrix[i][i] = 1.0;
+  }
+  return result;
+}
+
 S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
   S21Matrix result(*this);
   result.SumMatrix(other);
@@ -114,8 +485,16 @@ S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
 }
 
 S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
+  if (cols_ != other.rows_)
+    throw std::runtime_error(
+        "The number of columns of the first matrix is not equal to the number "
+        "of rows of the second matrix");
+  S21OpScope scope(S21Op::kMulMatrix, rows_, other.cols_,
+                   2.0 * rows_ * cols_ * other.cols_,
+                   8.0 * rows_ * cols_ + 8.0 * other.rows_ * other.cols_ +
+                       8.0 * rows_ * other.cols_);
+  S21Matrix result(rows_, other.cols_);
+  result.Gemm(*this, other);
   return result;
 }
 
@@ -131,17 +510,27 @@ bool S21Matrix::operator==(const S21Matrix& other) const {
 
 S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
   if (this != &other) {  // Проверка на самоприсваивание
-    // Освобождаем текущие ресурсы
-    s21_remove_matrix(this->matrix_);
-    // Выделяем новую память и копируем данные
-    s21_create_matrix(other.rows_, other.cols_, this->matrix_);
-    this->rows_ = other.rows_;
-    this->cols_ = other.cols_;
-    *this += other;
+    S21OpScope scope(S21Op::kAssign, other.rows_, other.cols_, 0,
+                     16.0 * other.rows_ * other.cols_);
+    // Копия создается до освобождения текущих данных, поэтому при нехватке
+    // памяти матрица остается прежней
+    S21Matrix copy(other);
+    *this = std::move(copy);
   }
   return *this;
 }
 
+S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
+  std::swap(matrix_, other.matrix_);
+  std::swap(storage_, other.storage_);
+  std::swap(read_only_, other.read_only_);
+  std::swap(shared_, other.shared_);
+  std::swap(unshareable_, other.unshareable_);
+  std::swap(rows_, other.rows_);
+  std::swap(cols_, other.cols_);
+  return *this;
+}
+
 S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
   (*this).SumMatrix(other);
   return *this;
@@ -166,6 +555,8 @@ double& S21Matrix::operator()(int row, int col) {
   if ((row < 0 || row >= this->rows_) || (col < 0 || col >= this->cols_)) {
     throw std::runtime_error("Index is outside the matrix");
   } else {
+    Detach();
+    unshareable_ = true;
     return this->matrix_->matrix[row][col];
   }
 }
@@ -180,9 +571,10 @@ double S21Matrix::get_element_matrix_(int row, int col) const {
   }
 }
 void S21Matrix::set_rows(int rows) {
-  if (rows <= 0) {
-    throw std::runtime_error("Incorrect rows");
-  } else if (rows < this->rows_) {
+  if (rows <= 0) throw std::runtime_error("Incorrect rows");
+  S21OpScope scope(S21Op::kResize, rows, cols_, 0,
+                   16.0 * std::min(rows, rows_) * cols_);
+  if (rows < this->rows_) {
     S21Matrix result(rows, this->cols_);
     this->rows_ = rows;
     for (int i = 0; i < this->rows_; i++) {
@@ -203,9 +595,10 @@ void S21Matrix::set_rows(int rows) {
   }
 }
 void S21Matrix::set_cols(int cols) {
-  if (cols <= 0) {
-    throw std::runtime_error("Incorrect cols");
-  } else if (cols < this->cols_) {
+  if (cols <= 0) throw std::runtime_error("Incorrect cols");
+  S21OpScope scope(S21Op::kResize, rows_, cols, 0,
+                   16.0 * rows_ * std::min(cols, cols_));
+  if (cols < this->cols_) {
     S21Matrix result(this->rows_, cols);
     this->cols_ = cols;
     for (int i = 0; i < this->rows_; i++) {
@@ -229,6 +622,7 @@ void S21Matrix::set_element_matrix_(int row, int col, double element) {
   if ((row < 0 || row >= this->rows_) || (col < 0 || col >= this->cols_)) {
     throw std::runtime_error("Index is outside the matrix");
   } else {
+    Detach();
     this->matrix_->matrix[row][col] = element;
   }
 }
@@ -1,36 +1,129 @@
 #ifndef S21_MATRIX_H_
 #define S21_MATRIX_H_
 
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "s21_matrix/s21_matrix.h"
+#include "s21_memory.hpp"
 
 #pragma once  // Предотвращает многократное включение файла
 
+class S21Workspace;
+
+// How S21Matrix::Map maps a file: kReadOnly shares the pages with the file
+// and copies the matrix into memory on the first mutation, kCopyOnWrite
+// maps them privately so that writes stay in this process.
+enum class S21MapMode { kReadOnly, kCopyOnWrite };
+
 class S21Matrix {
+  friend class S21PackedMatrix;
+  friend class S21Workspace;
+  friend class S21InverseUpdater;
+  friend class S21MaintainedProduct;
+  friend class S21TileCache;
+
  private:
   matrix_t* matrix_;
   int rows_, cols_;
+  // Owner of elements that s21_create_matrix did not allocate (a file
+  // mapping or a wrapped buffer); matrix_ then holds only row pointers into
+  // them.
+  std::shared_ptr<void> storage_;
+  bool read_only_ = false;
+  // storage_ owns matrix_ itself, which copies made in copy-on-write mode
+  // share until one of them is written.
+  bool shared_ = false;
+  // operator() has handed out a reference into the elements, so copies
+  // must not share them.
+  bool unshareable_ = false;
+
+  void Release();
+  // Hands a fresh matrix_ over to storage_ for sharing.
+  void Share();
+  // Gives a read-only or shared matrix its own storage before it is
+  // written.
+  void Detach();
+  void SymmetricEigen(std::vector<double>* values, S21Matrix* vectors,
+                      int first, int last) const;
 
  public:
   // Constructors & Destructor
   S21Matrix();  // Конструктор по умолчанию
   S21Matrix(int rows, int cols);  // Параметрический конструктор
+  // In copy-on-write mode a copy shares the elements and row pointers with
+  // its source, allocating nothing, and a matrix gets its own elements on
+  // the first write through operator() or a mutating member. A matrix that
+  // has handed out a reference through operator() is copied element by
+  // element until its storage is replaced; set_element_matrix_ writes
+  // without that.
   S21Matrix(const S21Matrix& other);  // Конструктор копирования
   S21Matrix(S21Matrix&& other) noexcept;  // Конструктор перемещения
+  // Wraps rows x cols elements at data, rows ld elements apart (0 for
+  // cols), without copying them. In-place operations write through to
+  // data; assignment and the ones that change the shape leave the buffer
+  // and give the matrix storage of its own. Copies are deep; when the
+  // wrapper lets go of data it calls deleter(data), if there is one.
+  S21Matrix(double* data, int rows, int cols, long ld = 0,
+            std::function<void(double*)> deleter = nullptr);
+  // Read-only elements: they are copied into storage of the matrix's own
+  // on the first write.
+  S21Matrix(const double* data, int rows, int cols, long ld = 0);
   ~S21Matrix();                           // Деструктор
 
+  // Copy-on-write mode for all matrices, off by default. Matrices created
+  // while it is off are still copied element by element.
+  static void SetCopyOnWrite(bool enabled);
+  static bool CopyOnWrite();
+
   // Basic Operations
   bool EqMatrix(const S21Matrix& other) const;
   void SumMatrix(const S21Matrix& other);
   void SubMatrix(const S21Matrix& other);
   void MulNumber(const double num);
   void MulMatrix(const S21Matrix& other);
+  S21Matrix Syrk(bool transpose = false) const;
+  void Gemm(const S21Matrix& a, const S21Matrix& b, double alpha = 1.0,
+            double beta = 0.0, bool transpose_a = false,
+            bool transpose_b = false);
   S21Matrix Transpose() const;
   S21Matrix CalcComplements() const;
   double Determinant() const;
   S21Matrix InverseMatrix() const;
+  S21Matrix Pow(int power) const;
+  S21Matrix Expm() const;
+  void Expm(S21Matrix& result, S21Workspace& workspace) const;
+  // sum coefficients[i] * A^i evaluated with Paterson-Stockmeyer.
+  S21Matrix Polynomial(const std::vector<double>& coefficients) const;
+  void Polynomial(const std::vector<double>& coefficients, S21Matrix& result,
+                  S21Workspace& workspace) const;
+  void QrDecomposition(S21Matrix& q, S21Matrix& r) const;
+  // Lower triangular L with L * L^T equal to this symmetric matrix.
+  S21Matrix Cholesky() const;
+  S21Matrix SolveLeastSquares(const S21Matrix& b) const;
+  // Rank-`rank` approximation A ~ u * diag(s) * vt from a randomized range
+  // finder: u is rows x rank, vt is rank x cols.
+  void RandomizedSvd(int rank, int oversampling, int power_iterations,
+                     S21Matrix& u, std::vector<double>& s, S21Matrix& vt,
+                     unsigned seed = 0) const;
+  // Eigenvalues first..last (ascending, last = -1 for the largest) of a
+  // symmetric matrix; vectors receives the eigenvectors as columns.
+  std::vector<double> SymmetricEigenvalues(int first = 0, int last = -1) const;
+  void SymmetricEigen(std::vector<double>& values, S21Matrix& vectors,
+                      int first = 0, int last = -1) const;
+  // Multiplies a chain in the order with the lowest estimated kernel cost.
+  static S21Matrix MulChain(
+      const std::vector<std::reference_wrapper<const S21Matrix>>& chain);
+  static std::string MulChainOrder(
+      const std::vector<std::reference_wrapper<const S21Matrix>>& chain);
+  void Gemv(double alpha, const std::vector<double>& x, double beta,
+            std::vector<double>& y, bool transpose = false) const;
+  void Ger(double alpha, const std::vector<double>& x,
+           const std::vector<double>& y);
 
   // Operator Overloads
   S21Matrix operator+(const S21Matrix& other) const;
@@ -39,6 +132,7 @@ class S21Matrix {
   S21Matrix operator*(const double num) const;
   bool operator==(const S21Matrix& other) const;
   S21Matrix& operator=(const S21Matrix& other);
+  S21Matrix& operator=(S21Matrix&& other) noexcept;
   S21Matrix& operator+=(const S21Matrix& other);
   S21Matrix& operator-=(const S21Matrix& other);
   S21Matrix& operator*=(const S21Matrix& other);
@@ -52,6 +146,55 @@ class S21Matrix {
   void set_rows(int rows);
   void set_cols(int cols);
   void set_element_matrix_(int row, int col, double element);
+
+  // Binary file: a 64-byte little-endian header, then the elements from
+  // byte offset on, row-major, rows ld elements apart:
+  //   0  char[8]  magic "S21MATRX"     24 int64   rows
+  //   8  uint32   version (1)          32 int64   cols
+  //   12 uint32   dtype (1 = float64)  40 int64   ld, >= cols
+  //   16 uint32   layout (0 = rows)    48 uint64  offset, multiple of 64
+  //   20 uint32   reserved             56 uint64  checksum
+  // The checksum is FNV-1a over the rows * ld elements as 64-bit words.
+  void Save(const std::string& path) const;
+  static S21Matrix Load(const std::string& path);
+  // Maps the file instead of reading it: pages load on first access and
+  // nothing is parsed or copied; verify reads it all for the checksum.
+  static S21Matrix Map(const std::string& path,
+                       S21MapMode mode = S21MapMode::kReadOnly,
+                       bool verify = false);
+
+  // Text files, parsed and formatted in parallel chunks. CSV has a row per
+  // line and fields split by delimiter (a blank delimiter takes runs of
+  // blanks); blank lines are skipped. MatrixMarket is written as a general
+  // array; reading also takes coordinate files, general or symmetric.
+  void SaveCsv(const std::string& path, char delimiter = ',') const;
+  static S21Matrix LoadCsv(const std::string& path, char delimiter = ',');
+  void SaveMatrixMarket(const std::string& path) const;
+  static S21Matrix LoadMatrixMarket(const std::string& path);
+  // Reads a CSV file block_rows rows at a time (the last block may be
+  // shorter) and hands each block to consumer with the index of its first
+  // row, so the file never has to fit in memory.
+  static void StreamCsv(
+      const std::string& path, int block_rows,
+      const std::function<void(const S21Matrix& block, int first_row)>&
+          consumer,
+      char delimiter = ',');
+};
+
+// Scratch matrices kept between calls of Expm and Polynomial, so repeated
+// evaluations of the same size allocate nothing.
+class S21Workspace {
+  friend class S21Matrix;
+
+ private:
+  std::vector<S21Matrix> buffers_;
+  std::vector<int> pivots_;
+
+  void Prepare(std::size_t count, int rows, int cols);
+  // Hands buffers_[index] over as result. A result wrapping an external
+  // buffer gets a copy instead, so the buffer receives the values and does
+  // not become scratch of the next call.
+  void Deliver(std::size_t index, S21Matrix& result);
 };
 
 #endif  // S21_MATRIX_H_
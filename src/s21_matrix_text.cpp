@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_metrics.hpp"
+
+namespace {
+
+// Text below this size is parsed or formatted by a single thread.
+constexpr std::size_t kChunkBytes = 1 << 20;
+// StreamCsv reads the file in pieces of this size.
+constexpr std::size_t kStreamBytes = 8 << 20;
+// The longest shortest-round-trip form of a double and a separator.
+constexpr std::size_t kNumberWidth = 25;
+
+constexpr char kBanner[] = "%%MatrixMarket";
+
+bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char* LineEnd(const char* p, const char* end) {
+  const void* newline = std::memchr(p, '\n', end - p);
+  return newline ? static_cast<const char*>(newline) : end;
+}
+
+bool BlankLine(const char* p, const char* end) {
+  while (p < end && IsBlank(*p)) p++;
+  return p == end;
+}
+
+// Parses at most count fields of the line [p, end) into out (if not null)
+// and returns how many there were, or -1 if the line is malformed.
+int ParseLine(const char* p, const char* end, char delimiter, double* out,
+              int count) {
+  bool blank_delimiter = IsBlank(delimiter);
+  int fields = 0;
+  for (;;) {
+    while (p < end && IsBlank(*p) && *p != delimiter) p++;
+    if (p < end && *p == '+') p++;
+    double value;
+    std::from_chars_result parsed = std::from_chars(p, end, value);
+    if (parsed.ec != std::errc() || fields == count) return -1;
+    if (out) out[fields] = value;
+    fields++;
+    p = parsed.ptr;
+    const char* gap = p;
+    while (p < end && IsBlank(*p) && (blank_delimiter || *p != delimiter))
+      p++;
+    if (p == end) return fields;
+    if (blank_delimiter ? p == gap : *p++ != delimiter) return -1;
+  }
+}
+
+// Runs task(0) .. task(count - 1), all but the first on threads of their
+// own, and rethrows what any of them threw.
+template <class Task>
+void RunParallel(std::size_t count, const Task& task) {
+  std::vector<std::future<void>> others;
+  for (std::size_t i = 1; i < count; i++)
+    others.push_back(std::async(std::launch::async, task, i));
+  if (count > 0) task(0);
+  for (auto& other : others) other.get();
+}
+
+std::size_t ThreadsFor(std::size_t bytes) {
+  std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  return std::min(threads, bytes / kChunkBytes + 1);
+}
+
+// A piece of text that starts and ends at line boundaries; first_line
+// counts the non-blank lines before it.
+struct Chunk {
+  const char* begin;
+  const char* end;
+  long first_line, lines;
+};
+
+// Splits the text into a chunk per thread and counts their lines in
+// parallel.
+std::vector<Chunk> SplitLines(const char* begin, const char* end) {
+  std::size_t size = end - begin, pieces = ThreadsFor(size);
+  std::vector<Chunk> chunks;
+  for (const char* from = begin; from < end;) {
+    const char* cut = begin + size * (chunks.size() + 1) / pieces;
+    cut = std::min(LineEnd(std::max(from, cut), end) + 1, end);
+    chunks.push_back({from, cut, 0, 0});
+    from = cut;
+  }
+  RunParallel(chunks.size(), [&](std::size_t i) {
+    for (const char* p = chunks[i].begin; p < chunks[i].end;) {
+      const char* line = LineEnd(p, chunks[i].end);
+      if (!BlankLine(p, line)) chunks[i].lines++;
+      p = line + 1;
+    }
+  });
+  for (std::size_t i = 1; i < chunks.size(); i++)
+    chunks[i].first_line = chunks[i - 1].first_line + chunks[i - 1].lines;
+  return chunks;
+}
+
+long LinesOf(const std::vector<Chunk>& chunks) {
+  return chunks.empty() ? 0 : chunks.back().first_line + chunks.back().lines;
+}
+
+// Calls parse(line, begin, end) for every non-blank line, a thread per
+// chunk; line is the index among the non-blank lines.
+template <class Parse>
+void ParseLines(const std::vector<Chunk>& chunks, const Parse& parse) {
+  RunParallel(chunks.size(), [&](std::size_t i) {
+    long line = chunks[i].first_line;
+    for (const char* p = chunks[i].begin; p < chunks[i].end;) {
+      const char* end = LineEnd(p, chunks[i].end);
+      if (!BlankLine(p, end)) parse(line++, p, end);
+      p = end + 1;
+    }
+  });
+}
+
+// The number of fields on the first non-blank line.
+int CountFields(const char* p, const char* end, char delimiter,
+                const std::string& path) {
+  int fields = -1;
+  while (p < end && fields < 0) {
+    const char* line = LineEnd(p, end);
+    if (!BlankLine(p, line))
+      fields = std::max(ParseLine(p, line, delimiter, nullptr, INT_MAX), 0);
+    p = line + 1;
+  }
+  if (fields <= 0) throw std::runtime_error("Cannot parse " + path);
+  return fields;
+}
+
+void ParseCsvRows(const std::vector<Chunk>& chunks, char delimiter,
+                  int cols, double** rows, long first_row,
+                  const std::string& path) {
+  ParseLines(chunks, [&](long row, const char* begin, const char* end) {
+    if (ParseLine(begin, end, delimiter, rows[row], cols) != cols)
+      throw std::runtime_error("Malformed row " +
+                               std::to_string(first_row + row + 1) + " in " +
+                               path);
+  });
+}
+
+std::string ReadText(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) throw std::runtime_error("Cannot read " + path);
+  std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+  file.seekg(0);
+  if (!file.read(&text[0], text.size()))
+    throw std::runtime_error("Cannot read " + path);
+  return text;
+}
+
+// Writes header, then lines 0 .. count - 1, each made by format(line, out)
+// with at most width characters at out, returning the new end. Groups of
+// lines are formatted in parallel and written in order, so only a group is
+// ever held in memory.
+template <class Format>
+void WriteLines(const std::string& path, const std::string& header,
+                long count, std::size_t width, const Format& format) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("Cannot write " + path);
+  file << header;
+  std::size_t threads = ThreadsFor(count * width);
+  long group = std::max(1L, static_cast<long>(kChunkBytes / width));
+  std::vector<std::string> texts(threads);
+  for (long first = 0; first < count; first += group * threads) {
+    RunParallel(threads, [&](std::size_t t) {
+      long begin = std::min(count, first + group * static_cast<long>(t));
+      long end = std::min(count, begin + group);
+      std::string& text = texts[t];
+      text.resize((end - begin) * width);
+      char* out = &text[0];
+      for (long line = begin; line < end; line++) out = format(line, out);
+      text.resize(out - text.data());
+    });
+    for (const std::string& text : texts) file.write(text.data(), text.size());
+  }
+  if (!file.flush()) throw std::runtime_error("Cannot write " + path);
+}
+
+char* FormatNumber(char* out, double value) {
+  return std::to_chars(out, out + kNumberWidth, value).ptr;
+}
+
+// A positive integer from a MatrixMarket size line or index, at most limit.
+long ToIndex(double value, long limit) {
+  return value >= 1 && value <= limit && std::floor(value) == value
+             ? static_cast<long>(value)
+             : -1;
+}
+
+}  // namespace
+
+void S21Matrix::SaveCsv(const std::string& path, char delimiter) const {
+  S21OpScope scope(S21Op::kSaveCsv, rows_, cols_, 0, 8.0 * rows_ * cols_);
+  WriteLines(path, "", rows_, kNumberWidth * cols_ + 1,
+             [&](long row, char* out) {
+               for (int j = 0; j < cols_; j++) {
+                 if (j > 0) *out++ = delimiter;
+                 out = FormatNumber(out, matrix_->matrix[row][j]);
+               }
+               *out++ = '\n';
+               return out;
+             });
+}
+
+S21Matrix S21Matrix::LoadCsv(const std::string& path, char delimiter) {
+  S21OpScope scope(S21Op::kLoadCsv, 0, 0, 0, 0);
+  std::string text = ReadText(path);
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+  int cols = CountFields(begin, end, delimiter, path);
+  std::vector<Chunk> chunks = SplitLines(begin, end);
+  if (LinesOf(chunks) > INT_MAX)
+    throw std::runtime_error("Too many rows in " + path);
+  int rows = static_cast<int>(LinesOf(chunks));
+  scope.Result(rows, cols, 8.0 * rows * cols);
+  S21Matrix result(rows, cols);
+  ParseCsvRows(chunks, delimiter, cols, result.matrix_->matrix, 0, path);
+  return result;
+}
+
+void S21Matrix::StreamCsv(
+    const std::string& path, int block_rows,
+    const std::function<void(const S21Matrix& block, int first_row)>&
+        consumer,
+    char delimiter) {
+  if (block_rows <= 0) throw std::runtime_error("Incorrect matrix");
+  std::ifstream file(path, std::ios::binary);
+  if (!file) throw std::runtime_error("Cannot read " + path);
+  std::string buffer;
+  S21Matrix block;
+  // The lines of the next block are [start, scan), counted of them.
+  std::size_t start = 0, scan = 0;
+  int counted = 0, cols = 0, first_row = 0;
+  bool eof = false;
+  for (;;) {
+    while (counted < block_rows) {
+      const char* data = buffer.data();
+      const char* line = LineEnd(data + scan, data + buffer.size());
+      if (line == data + buffer.size() && (!eof || line == data + scan))
+        break;
+      std::size_t next = std::min<std::size_t>(line - data + 1, buffer.size());
+      if (!BlankLine(data + scan, line)) counted++;
+      scan = next;
+    }
+    if (counted == block_rows || (eof && counted > 0)) {
+      const char* begin = buffer.data() + start;
+      const char* end = buffer.data() + scan;
+      {
+        S21OpScope scope(S21Op::kStreamCsv, counted, cols, 0, 0);
+        if (cols == 0) cols = CountFields(begin, end, delimiter, path);
+        scope.Result(counted, cols, 8.0 * counted * cols);
+        if (block.get_rows() != counted || block.get_cols() != cols)
+          block = S21Matrix(counted, cols);
+        // The consumer may have kept a copy sharing the last block.
+        block.Detach();
+        ParseCsvRows(SplitLines(begin, end), delimiter, cols,
+                     block.matrix_->matrix, first_row, path);
+      }
+      consumer(block, first_row);
+      first_row += counted;
+      counted = 0;
+      start = scan;
+    } else if (eof) {
+      break;
+    } else {
+      buffer.erase(0, start);
+      scan -= start;
+      start = 0;
+      std::size_t size = buffer.size();
+      buffer.resize(size + kStreamBytes);
+      file.read(&buffer[size], kStreamBytes);
+      buffer.resize(size + file.gcount());
+      eof = !file;
+    }
+  }
+}
+
+void S21Matrix::SaveMatrixMarket(const std::string& path) const {
+  S21OpScope scope(S21Op::kSaveMatrixMarket, rows_, cols_, 0,
+                   8.0 * rows_ * cols_);
+  std::string header = std::string(kBanner) + " matrix array real general\n" +
+                       std::to_string(rows_) + " " + std::to_string(cols_) +
+                       "\n";
+  WriteLines(path, header, static_cast<long>(rows_) * cols_, kNumberWidth + 1,
+             [&](long index, char* out) {
+               out = FormatNumber(out, matrix_->matrix[index % rows_]
+                                                      [index / rows_]);
+               *out++ = '\n';
+               return out;
+             });
+}
+
+S21Matrix S21Matrix::LoadMatrixMarket(const std::string& path) {
+  S21OpScope scope(S21Op::kLoadMatrixMarket, 0, 0, 0, 0);
+  std::string text = ReadText(path);
+  const char* p = text.data();
+  const char* end = p + text.size();
+  const char* line = LineEnd(p, end);
+  std::istringstream banner(std::string(p, line));
+  std::string word, object, format, field, symmetry;
+  banner >> word >> object >> format >> field >> symmetry;
+  for (std::string* name : {&object, &format, &field, &symmetry})
+    std::transform(name->begin(), name->end(), name->begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+  if (word != kBanner || object != "matrix")
+    throw std::runtime_error("Not a MatrixMarket file: " + path);
+  bool coordinate = format == "coordinate";
+  bool symmetric = symmetry == "symmetric";
+  if ((!coordinate && format != "array") ||
+      (field != "real" && field != "double" && field != "integer") ||
+      (symmetry != "general" && !(coordinate && symmetric)))
+    throw std::runtime_error("Unsupported MatrixMarket file: " + path);
+  do {
+    p = line + 1;
+    line = LineEnd(p, end);
+  } while (p < end && (*p == '%' || BlankLine(p, line)));
+  double size[3];
+  int fields = coordinate ? 3 : 1;
+  long rows = -1, cols = -1, entries = -1;
+  if (p < end && ParseLine(p, line, ' ', size, 3) == (coordinate ? 3 : 2)) {
+    rows = ToIndex(size[0], INT_MAX);
+    cols = ToIndex(size[1], INT_MAX);
+    entries = coordinate ? ToIndex(size[2] + 1, LONG_MAX) - 1 : rows * cols;
+  }
+  std::vector<Chunk> chunks = SplitLines(std::min(line + 1, end), end);
+  if (rows < 0 || cols < 0 || entries < 0 || LinesOf(chunks) != entries ||
+      (symmetric && rows != cols))
+    throw std::runtime_error("Corrupted MatrixMarket file: " + path);
+  scope.Result(static_cast<int>(rows), static_cast<int>(cols),
+               8.0 * rows * cols);
+  S21Matrix result(static_cast<int>(rows), static_cast<int>(cols));
+  double** elements = result.matrix_->matrix;
+  ParseLines(chunks, [&](long index, const char* first, const char* last) {
+    double entry[3];
+    long i = index % rows, j = index / rows;
+    if (ParseLine(first, last, ' ', entry, fields) != fields ||
+        (coordinate && ((i = ToIndex(entry[0], rows) - 1) < 0 ||
+                        (j = ToIndex(entry[1], cols) - 1) < 0)))
+      throw std::runtime_error("Malformed entry " + std::to_string(index + 1) +
+                               " in " + path);
+    elements[i][j] = entry[fields - 1];
+    if (symmetric) elements[j][i] = entry[fields - 1];
+  });
+  return result;
+}
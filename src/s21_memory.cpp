@@ -0,0 +1,35 @@
+#include "s21_memory.hpp"
+
+#include "s21_matrix/s21_matrix.h"
+
+namespace {
+
+S21MemoryStats Stats(int thread) {
+  s21_memory_stats_t stats;
+  s21_memory_stats(thread, &stats);
+  S21MemoryStats result;
+  result.live_bytes = stats.live_bytes;
+  result.peak_bytes = stats.peak_bytes;
+  result.allocations = stats.allocations;
+  result.failures = stats.failures;
+  return result;
+}
+
+}  // namespace
+
+void S21Memory::SetBudget(std::int64_t bytes) { s21_memory_set_budget(bytes); }
+
+std::int64_t S21Memory::Budget() { return s21_memory_budget(); }
+
+S21MemoryStats S21Memory::Global() { return Stats(0); }
+
+S21MemoryStats S21Memory::Thread() { return Stats(1); }
+
+void S21Memory::ResetPeak() { s21_memory_reset_peak(); }
+
+bool S21Memory::Fits(double bytes) { return s21_memory_fits(bytes); }
+
+void S21Memory::Check(int error) {
+  if (error == MEMORY_ERROR)
+    throw S21MemoryError("Not enough memory within the budget");
+}
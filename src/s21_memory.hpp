@@ -0,0 +1,40 @@
+#ifndef S21_MEMORY_H_
+#define S21_MEMORY_H_
+
+#include <cstdint>
+#include <stdexcept>
+
+#pragma once
+
+// Thrown when a matrix or kernel scratch would exceed the memory budget or
+// the system is out of memory.
+class S21MemoryError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+struct S21MemoryStats {
+  std::int64_t live_bytes = 0, peak_bytes = 0;
+  std::int64_t allocations = 0, failures = 0;
+};
+
+// Accounting of every matrix and kernel scratch allocation of the library,
+// globally and per thread, with an optional budget on the global live
+// bytes. Kernels check the budget up front and fall back to variants with
+// less scratch (smaller GEMM packs and panels, no LAPACK copies, Pow
+// without a base buffer) before giving up with S21MemoryError.
+class S21Memory {
+ public:
+  // 0 removes the budget.
+  static void SetBudget(std::int64_t bytes);
+  static std::int64_t Budget();
+  static S21MemoryStats Global();
+  // Live bytes of a thread are those it allocated minus those it freed.
+  static S21MemoryStats Thread();
+  static void ResetPeak();
+  static bool Fits(double bytes);
+  // Throws S21MemoryError for the MEMORY_ERROR status of the C kernels.
+  static void Check(int error);
+};
+
+#endif  // S21_MEMORY_H_
@@ -0,0 +1,293 @@
+#include "s21_metrics.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr int kOpCount = static_cast<int>(S21Op::kCount);
+
+const char* const kOpNames[kOpCount] = {
+    "SumMatrix",         "SubMatrix",         "MulNumber",
+    "MulMatrix",         "MulChain",          "Gemm",
+    "Syrk",              "Gemv",              "Ger",
+    "Transpose",         "CalcComplements",   "Determinant",
+    "InverseMatrix",     "EqMatrix",          "Assign",
+    "Resize",            "Pow",               "Expm",
+    "Polynomial",        "QrDecomposition",   "Cholesky",
+    "SolveLeastSquares", "SymmetricEigen",    "RandomizedSvd",
+    "Save",              "Load",              "Map",
+    "SaveCsv",           "LoadCsv",           "StreamCsv",
+    "SaveMatrixMarket",  "LoadMatrixMarket"};
+
+using Counter = std::atomic<std::uint64_t>;
+
+struct OpCounters {
+  Counter calls{0}, flops{0}, bytes{0}, allocations{0}, latency_ns{0};
+  Counter hardware[kS21HwCounters] = {}, hardware_calls[kS21HwCounters] = {};
+  Counter latency[S21OpStats::kLatencyBuckets] = {};
+  Counter shapes[S21OpStats::kShapeBuckets][S21OpStats::kShapeBuckets] = {};
+};
+
+OpCounters counters[kOpCount];
+
+std::int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Smallest bucket whose bound 2^(bucket + shift) covers value.
+int Bucket(std::uint64_t value, int shift, int buckets) {
+  int bucket = 0;
+  while (bucket < buckets - 1 && value > (std::uint64_t{1} << (bucket + shift)))
+    bucket++;
+  return bucket;
+}
+
+// An estimate as a counter increment, clamped to what uint64 holds; NaN
+// counts as 0.
+std::uint64_t Saturate(double value) {
+  if (!(value > 0)) return 0;
+  if (value >= 18446744073709551616.0) return UINT64_MAX;
+  return static_cast<std::uint64_t>(value);
+}
+
+void Add(Counter& counter, std::uint64_t value) {
+  counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+void WriteFile(const std::string& path, const std::string& text) {
+  std::ofstream file(path);
+  file << text;
+  if (!file) throw std::runtime_error("Cannot write " + path);
+}
+
+}  // namespace
+
+const char* S21OpName(S21Op op) { return kOpNames[static_cast<int>(op)]; }
+
+double S21OpStats::LatencyBound(int bucket) {
+  return static_cast<double>(std::uint64_t{1} << (bucket + 8));
+}
+
+void S21Metrics::Enable(bool enabled) { enabled_.store(enabled); }
+
+bool S21Metrics::Enabled() { return enabled_.load(); }
+
+bool S21Metrics::EnableHardwareCounters(bool enabled) {
+  bool available = enabled && S21HwCounters::Available();
+  hardware_.store(available);
+  return available;
+}
+
+void S21Metrics::Reset() {
+  for (OpCounters& op : counters) {
+    op.calls = op.flops = op.bytes = op.allocations = op.latency_ns = 0;
+    for (Counter& bucket : op.latency) bucket = 0;
+    for (int i = 0; i < kS21HwCounters; i++)
+      op.hardware[i] = op.hardware_calls[i] = 0;
+    for (auto& row : op.shapes) {
+      for (Counter& bucket : row) bucket = 0;
+    }
+  }
+}
+
+std::vector<S21OpStats> S21Metrics::Snapshot() {
+  std::vector<S21OpStats> snapshot;
+  for (int i = 0; i < kOpCount; i++) {
+    const OpCounters& op = counters[i];
+    if (op.calls.load() == 0) continue;
+    S21OpStats stats;
+    stats.name = kOpNames[i];
+    stats.calls = op.calls.load();
+    stats.flops = op.flops.load();
+    stats.bytes = op.bytes.load();
+    stats.allocations = op.allocations.load();
+    stats.latency_ns = op.latency_ns.load();
+    for (int i = 0; i < kS21HwCounters; i++) {
+      stats.hardware[i] = op.hardware[i].load();
+      stats.hardware_calls[i] = op.hardware_calls[i].load();
+    }
+    for (int b = 0; b < S21OpStats::kLatencyBuckets; b++) {
+      stats.latency[b] = op.latency[b].load();
+    }
+    for (int r = 0; r < S21OpStats::kShapeBuckets; r++) {
+      for (int c = 0; c < S21OpStats::kShapeBuckets; c++) {
+        stats.shapes[r][c] = op.shapes[r][c].load();
+      }
+    }
+    snapshot.push_back(stats);
+  }
+  return snapshot;
+}
+
+// Prometheus text exposition format: counters per operation, latency as a
+// cumulative histogram in seconds and the shapes seen as a labelled counter.
+std::string S21Metrics::Prometheus() {
+  std::ostringstream out;
+  std::vector<S21OpStats> snapshot = Snapshot();
+  const char* const totals[][2] = {
+      {"calls", "Calls of the operation."},
+      {"flops", "Floating point operations performed."},
+      {"bytes", "Bytes of matrix data read and written."},
+      {"allocations", "Matrices allocated inside the operation."}};
+  for (int t = 0; t < 4; t++) {
+    out << "# HELP s21_matrix_" << totals[t][0] << "_total " << totals[t][1]
+        << "\n# TYPE s21_matrix_" << totals[t][0] << "_total counter\n";
+    for (const S21OpStats& stats : snapshot) {
+      std::uint64_t value = t == 0   ? stats.calls
+                            : t == 1 ? stats.flops
+                            : t == 2 ? stats.bytes
+                                     : stats.allocations;
+      out << "s21_matrix_" << totals[t][0] << "_total{op=\"" << stats.name
+          << "\"} " << value << "\n";
+    }
+  }
+  for (int i = 0; i < kS21HwCounters; i++) {
+    const char* name = S21HwCounters::Name(static_cast<S21HwCounter>(i));
+    out << "# HELP s21_matrix_" << name << "_total Hardware counter " << name
+        << " of the calling thread only, user mode, over the calls it was"
+           " read in.\n"
+        << "# TYPE s21_matrix_" << name << "_total counter\n";
+    for (const S21OpStats& stats : snapshot) {
+      if (stats.hardware_calls[i] == 0) continue;
+      out << "s21_matrix_" << name << "_total{op=\"" << stats.name << "\"} "
+          << stats.hardware[i] << "\n";
+    }
+  }
+  out << "# HELP s21_matrix_latency_seconds Latency of the operation.\n"
+      << "# TYPE s21_matrix_latency_seconds histogram\n";
+  for (const S21OpStats& stats : snapshot) {
+    std::uint64_t cumulative = 0;
+    for (int b = 0; b < S21OpStats::kLatencyBuckets; b++) {
+      cumulative += stats.latency[b];
+      out << "s21_matrix_latency_seconds_bucket{op=\"" << stats.name
+          << "\",le=\"";
+      if (b == S21OpStats::kLatencyBuckets - 1) {
+        out << "+Inf";
+      } else {
+        out << S21OpStats::LatencyBound(b) * 1e-9;
+      }
+      out << "\"} " << cumulative << "\n";
+    }
+    out << "s21_matrix_latency_seconds_sum{op=\"" << stats.name << "\"} "
+        << stats.latency_ns * 1e-9 << "\n"
+        << "s21_matrix_latency_seconds_count{op=\"" << stats.name << "\"} "
+        << stats.calls << "\n";
+  }
+  out << "# HELP s21_matrix_shape_total Calls by rows and columns, rounded "
+         "up to powers of two.\n"
+      << "# TYPE s21_matrix_shape_total counter\n";
+  for (const S21OpStats& stats : snapshot) {
+    for (int r = 0; r < S21OpStats::kShapeBuckets; r++) {
+      for (int c = 0; c < S21OpStats::kShapeBuckets; c++) {
+        if (stats.shapes[r][c] == 0) continue;
+        out << "s21_matrix_shape_total{op=\"" << stats.name << "\",rows=\""
+            << (1 << r) << "\",cols=\"" << (1 << c) << "\"} "
+            << stats.shapes[r][c] << "\n";
+      }
+    }
+  }
+  return out.str();
+}
+
+std::string S21Metrics::Json() {
+  std::ostringstream out;
+  out << "{\"operations\":[";
+  bool first = true;
+  for (const S21OpStats& stats : Snapshot()) {
+    out << (first ? "" : ",") << "{\"name\":\"" << stats.name
+        << "\",\"calls\":" << stats.calls << ",\"flops\":" << stats.flops
+        << ",\"bytes\":" << stats.bytes
+        << ",\"allocations\":" << stats.allocations
+        << ",\"latency_ns_sum\":" << stats.latency_ns;
+    for (int i = 0; i < kS21HwCounters; i++) {
+      if (stats.hardware_calls[i] == 0) continue;
+      out << ",\"" << S21HwCounters::Name(static_cast<S21HwCounter>(i))
+          << "\":{\"total\":" << stats.hardware[i]
+          << ",\"calls\":" << stats.hardware_calls[i] << "}";
+    }
+    out << ",\"latency_ns\":[";
+    first = false;
+    bool first_bucket = true;
+    for (int b = 0; b < S21OpStats::kLatencyBuckets; b++) {
+      if (stats.latency[b] == 0) continue;
+      out << (first_bucket ? "" : ",") << "{\"le\":";
+      if (b == S21OpStats::kLatencyBuckets - 1) {
+        out << "null";
+      } else {
+        out << static_cast<std::uint64_t>(S21OpStats::LatencyBound(b));
+      }
+      out << ",\"count\":" << stats.latency[b] << "}";
+      first_bucket = false;
+    }
+    out << "],\"shapes\":[";
+    first_bucket = true;
+    for (int r = 0; r < S21OpStats::kShapeBuckets; r++) {
+      for (int c = 0; c < S21OpStats::kShapeBuckets; c++) {
+        if (stats.shapes[r][c] == 0) continue;
+        out << (first_bucket ? "" : ",") << "{\"rows\":" << (1 << r)
+            << ",\"cols\":" << (1 << c) << ",\"count\":" << stats.shapes[r][c]
+            << "}";
+        first_bucket = false;
+      }
+    }
+    out << "]}";
+  }
+  out << "]}\n";
+  return out.str();
+}
+
+void S21Metrics::WritePrometheus(const std::string& path) {
+  WriteFile(path, Prometheus());
+}
+
+void S21Metrics::WriteJson(const std::string& path) {
+  WriteFile(path, Json());
+}
+
+void S21OpScope::Begin() {
+  active_ = true;
+  traced_ = S21Trace::Enabled();
+  if (traced_) S21Trace::Record(S21OpName(op_), 'B', rows_, cols_);
+  metered_ = S21Metrics::Enabled();
+  if (!metered_) return;
+  outermost_ = S21Metrics::depth_++ == 0;
+  if (outermost_) {
+    allocations_ = S21Metrics::allocations_;
+    sampled_ = S21Metrics::hardware_.load(std::memory_order_relaxed) &&
+               S21HwCounters::Read(&hardware_);
+    start_ns_ = NowNs();
+  }
+}
+
+void S21OpScope::End() {
+  if (traced_) S21Trace::Record(S21OpName(op_), 'E', rows_, cols_, algorithm_);
+  if (!metered_) return;
+  S21Metrics::depth_--;
+  if (!outermost_) return;
+  std::uint64_t elapsed = static_cast<std::uint64_t>(NowNs() - start_ns_);
+  OpCounters& op = counters[static_cast<int>(op_)];
+  Add(op.calls, 1);
+  Add(op.flops, Saturate(flops_));
+  Add(op.bytes, Saturate(bytes_));
+  Add(op.allocations, S21Metrics::allocations_ - allocations_);
+  Add(op.latency_ns, elapsed);
+  S21HwSample hardware;
+  if (sampled_ && S21HwCounters::Read(&hardware)) {
+    for (int i = 0; i < kS21HwCounters; i++) {
+      if (!(hardware_.valid & hardware.valid & (1u << i))) continue;
+      Add(op.hardware[i], S21HwCounters::Delta(hardware_, hardware,
+                                               static_cast<S21HwCounter>(i)));
+      Add(op.hardware_calls[i], 1);
+    }
+  }
+  Add(op.latency[Bucket(elapsed, 8, S21OpStats::kLatencyBuckets)], 1);
+  int rows = Bucket(rows_ > 0 ? rows_ : 1, 0, S21OpStats::kShapeBuckets);
+  int cols = Bucket(cols_ > 0 ? cols_ : 1, 0, S21OpStats::kShapeBuckets);
+  Add(op.shapes[rows][cols], 1);
+}
@@ -0,0 +1,181 @@
+#ifndef S21_METRICS_H_
+#define S21_METRICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "s21_hw_counters.hpp"
+#include "s21_trace.hpp"
+
+#pragma once
+
+// Operations of S21Matrix that are measured. Only the outermost operation
+// of a call is recorded, so operator* shows up as MulMatrix and not as the
+// Gemm it runs on. StreamCsv is recorded once per block it parses, so the
+// work of its consumer is not counted as nested in it.
+enum class S21Op {
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,
+  kMulChain,
+  kGemm,
+  kSyrk,
+  kGemv,
+  kGer,
+  kTranspose,
+  kCalcComplements,
+  kDeterminant,
+  kInverseMatrix,
+  kEqMatrix,
+  kAssign,
+  kResize,
+  kPow,
+  kExpm,
+  kPolynomial,
+  kQrDecomposition,
+  kCholesky,
+  kSolveLeastSquares,
+  kSymmetricEigen,
+  kRandomizedSvd,
+  kSave,
+  kLoad,
+  kMap,
+  kSaveCsv,
+  kLoadCsv,
+  kStreamCsv,
+  kSaveMatrixMarket,
+  kLoadMatrixMarket,
+  kCount
+};
+
+const char* S21OpName(S21Op op);
+
+// Statistics of one operation. latency[i] counts calls that took at most
+// 2^(i + 8) ns, the last bucket everything slower; shapes[r][c] counts calls
+// whose result (or main operand) has at most 2^r rows and 2^c columns.
+// hardware[i] sums counter i over the hardware_calls[i] calls it was read
+// in, see S21Metrics::EnableHardwareCounters.
+struct S21OpStats {
+  static constexpr int kLatencyBuckets = 32;
+  static constexpr int kShapeBuckets = 14;
+
+  std::string name;
+  std::uint64_t calls = 0, flops = 0, bytes = 0, allocations = 0;
+  std::uint64_t latency_ns = 0;
+  std::array<std::uint64_t, kS21HwCounters> hardware{}, hardware_calls{};
+  std::array<std::uint64_t, kLatencyBuckets> latency{};
+  std::array<std::array<std::uint64_t, kShapeBuckets>, kShapeBuckets>
+      shapes{};
+
+  static double LatencyBound(int bucket);
+};
+
+// Opt-in instrumentation: disabled, every measured call costs one relaxed
+// atomic load. Enabled, counters are updated with relaxed atomics from any
+// thread.
+class S21Metrics {
+  friend class S21OpScope;
+
+ private:
+  static inline std::atomic<bool> enabled_{false}, hardware_{false};
+  static inline thread_local std::uint64_t allocations_ = 0;
+  static inline thread_local int depth_ = 0;
+
+ public:
+  static void Enable(bool enabled = true);
+  static bool Enabled();
+  // Also samples cycles, instructions and L1d, LLC and dTLB misses around
+  // every recorded operation, counting the calling thread only: the
+  // OpenMP workers of MulMatrix or Transpose are not included, hence the
+  // caller_ prefix of the exported names. Returns false, and records no
+  // counters, when perf events are unavailable.
+  static bool EnableHardwareCounters(bool enabled = true);
+  static void Reset();
+  // Operations called at least once since the last Reset.
+  static std::vector<S21OpStats> Snapshot();
+  static std::string Prometheus();
+  static std::string Json();
+  static void WritePrometheus(const std::string& path);
+  static void WriteJson(const std::string& path);
+
+  static void CountAllocation() {
+    if (enabled_.load(std::memory_order_relaxed)) allocations_++;
+  }
+
+  // Held by a helper thread of a measured operation, so that the operations
+  // it runs count as nested in that one and are not recorded again.
+  class Nested {
+   public:
+    Nested() { depth_++; }
+    ~Nested() { depth_--; }
+    Nested(const Nested&) = delete;
+    Nested& operator=(const Nested&) = delete;
+  };
+};
+
+// Estimated work of an operation, counted into S21OpStats flops and bytes.
+struct S21OpCost {
+  double flops, bytes;
+};
+
+// Measures the operation running in its lifetime; see S21Metrics. With
+// S21Trace enabled it also emits a span, nested operations included.
+// Callers build it once the arguments are validated.
+class S21OpScope {
+ private:
+  S21Op op_;
+  bool active_ = false, metered_ = false, traced_ = false, outermost_ = false;
+  const char* algorithm_ = nullptr;
+  int rows_, cols_;
+  double flops_, bytes_;
+  std::uint64_t allocations_ = 0;
+  std::int64_t start_ns_ = 0;
+  S21HwSample hardware_;
+  bool sampled_ = false;
+
+  static bool Wanted() {
+    return S21Metrics::enabled_.load(std::memory_order_relaxed) ||
+           S21Trace::enabled_.load(std::memory_order_relaxed);
+  }
+  void Begin();
+  void End();
+
+ public:
+  S21OpScope(S21Op op, int rows, int cols, double flops, double bytes)
+      : op_(op), rows_(rows), cols_(cols), flops_(flops), bytes_(bytes) {
+    if (Wanted()) Begin();
+  }
+  // For estimates that take a loop or a libm call: cost() returns the
+  // S21OpCost and runs only when the operation is measured or traced.
+  template <typename Cost>
+  S21OpScope(S21Op op, int rows, int cols, Cost cost)
+      : op_(op), rows_(rows), cols_(cols), flops_(0), bytes_(0) {
+    if (Wanted()) {
+      S21OpCost estimate = cost();
+      flops_ = estimate.flops;
+      bytes_ = estimate.bytes;
+      Begin();
+    }
+  }
+  ~S21OpScope() {
+    if (active_) End();
+  }
+  S21OpScope(const S21OpScope&) = delete;
+  S21OpScope& operator=(const S21OpScope&) = delete;
+
+  // Names the algorithm or backend the operation chose, shown on its span.
+  void Algorithm(const char* algorithm) { algorithm_ = algorithm; }
+  // For loads, whose shape is known only once the file is parsed: the shape
+  // and bytes recorded when the operation ends.
+  void Result(int rows, int cols, double bytes) {
+    rows_ = rows;
+    cols_ = cols;
+    bytes_ = bytes;
+  }
+};
+
+#endif  // S21_METRICS_H_
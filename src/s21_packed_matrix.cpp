@@ -0,0 +1,179 @@
+#include "s21_packed_matrix.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "s21_memory.hpp"
+
+S21PackedMatrix::S21PackedMatrix(int size, S21Structure structure, int lower,
+                                 int upper)
+    : packed_(nullptr) {
+  packed_ = new packed_t;
+  int error = s21_create_packed(size, static_cast<int>(structure), lower,
+                                upper, packed_);
+  if (error != 0) delete packed_;
+  if (error == 1) throw std::runtime_error("Incorrect matrix");
+  S21Memory::Check(error);
+}
+
+S21PackedMatrix::S21PackedMatrix(const S21Matrix& dense,
+                                 S21Structure structure, int lower, int upper)
+    : S21PackedMatrix(dense.get_rows(), structure, lower, upper) {
+  int error = s21_pack_matrix(dense.matrix_, packed_);
+  if (error != 0) throw std::runtime_error("The matrix is not square");
+}
+
+S21PackedMatrix::S21PackedMatrix(const S21PackedMatrix& other)
+    : S21PackedMatrix(other.packed_->size, other.get_structure(),
+                      other.packed_->lower, other.packed_->upper) {
+  std::memcpy(packed_->data, other.packed_->data,
+              get_stored_elements() * sizeof(double));
+}
+
+S21PackedMatrix::S21PackedMatrix(S21PackedMatrix&& other) noexcept
+    : packed_(other.packed_) {
+  other.packed_ = nullptr;
+}
+
+S21PackedMatrix::~S21PackedMatrix() {
+  if (packed_ != nullptr) {
+    s21_remove_packed(packed_);
+    delete packed_;
+    packed_ = nullptr;
+  }
+}
+
+S21PackedMatrix S21PackedMatrix::Syrk(const S21Matrix& a, bool transpose) {
+  S21PackedMatrix result(transpose ? a.get_cols() : a.get_rows(),
+                         S21Structure::kSymmetric);
+  matrix_t rows = {};
+  S21Memory::Check(s21_packed_rows(result.packed_, &rows));
+  int error = s21_syrk_lower(transpose, 1.0, a.matrix_, 0.0, &rows);
+  s21_remove_submatrix(&rows);
+  S21Memory::Check(error);
+  return result;
+}
+
+S21Matrix S21PackedMatrix::ToDense() const {
+  S21Matrix result(packed_->size, packed_->size);
+  s21_unpack_matrix(packed_, result.matrix_);
+  return result;
+}
+
+S21Matrix S21PackedMatrix::MulMatrix(const S21Matrix& other) const {
+  if (other.get_rows() != packed_->size)
+    throw std::runtime_error(
+        "The number of columns of the first matrix is not equal to the number "
+        "of rows of the second matrix");
+  S21Matrix result(packed_->size, other.get_cols());
+  s21_packed_mult_matrix(packed_, other.matrix_, result.matrix_);
+  return result;
+}
+
+void S21PackedMatrix::MulNumber(const double num) {
+  s21_packed_mult_number(packed_, num);
+}
+
+S21PackedMatrix S21PackedMatrix::Transpose() const {
+  S21Structure structure = get_structure();
+  if (structure == S21Structure::kUpperTriangular) {
+    structure = S21Structure::kLowerTriangular;
+  } else if (structure == S21Structure::kLowerTriangular) {
+    structure = S21Structure::kUpperTriangular;
+  }
+  S21PackedMatrix result(packed_->size, structure, packed_->upper,
+                         packed_->lower);
+  s21_packed_transpose(packed_, result.packed_);
+  return result;
+}
+
+double S21PackedMatrix::Determinant() const {
+  double result = 0;
+  S21Memory::Check(s21_packed_determinant(packed_, &result));
+  return result;
+}
+
+S21Matrix S21PackedMatrix::Solve(const S21Matrix& b) const {
+  if (b.get_rows() != packed_->size)
+    throw std::runtime_error("Different matrix dimensions");
+  S21Matrix result(b.get_rows(), b.get_cols());
+  int error = s21_packed_solve(packed_, b.matrix_, result.matrix_);
+  if (error == 2) throw std::runtime_error("Matrix determinant is 0");
+  S21Memory::Check(error);
+  return result;
+}
+
+S21PackedMatrix S21PackedMatrix::Combine(const S21PackedMatrix& other,
+                                         double sign) const {
+  if (packed_->size != other.packed_->size)
+    throw std::runtime_error("Different matrix dimensions");
+  packed_t* a = packed_;
+  packed_t* b = other.packed_;
+  int kind = a->kind;
+  if (a->kind == S21_DIAGONAL) {
+    kind = b->kind;
+  } else if (b->kind != S21_DIAGONAL && a->kind != b->kind) {
+    throw std::runtime_error("Different matrix structures");
+  }
+  S21PackedMatrix result(a->size, static_cast<S21Structure>(kind),
+                         std::max(a->lower, b->lower),
+                         std::max(a->upper, b->upper));
+  s21_packed_sum(a, b, sign, result.packed_);
+  return result;
+}
+
+S21PackedMatrix S21PackedMatrix::operator+(const S21PackedMatrix& other) const {
+  return Combine(other, 1.0);
+}
+
+S21PackedMatrix S21PackedMatrix::operator-(const S21PackedMatrix& other) const {
+  return Combine(other, -1.0);
+}
+
+S21Matrix S21PackedMatrix::operator*(const S21Matrix& other) const {
+  return MulMatrix(other);
+}
+
+S21PackedMatrix S21PackedMatrix::operator*(const double num) const {
+  S21PackedMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+S21PackedMatrix& S21PackedMatrix::operator=(const S21PackedMatrix& other) {
+  if (this != &other) *this = S21PackedMatrix(other);
+  return *this;
+}
+
+S21PackedMatrix& S21PackedMatrix::operator=(S21PackedMatrix&& other) noexcept {
+  std::swap(packed_, other.packed_);
+  return *this;
+}
+
+int S21PackedMatrix::get_size() const { return packed_->size; }
+S21Structure S21PackedMatrix::get_structure() const {
+  return static_cast<S21Structure>(packed_->kind);
+}
+int S21PackedMatrix::get_lower_bandwidth() const { return packed_->lower; }
+int S21PackedMatrix::get_upper_bandwidth() const { return packed_->upper; }
+std::size_t S21PackedMatrix::get_stored_elements() const {
+  return s21_packed_elements(packed_->size, packed_->kind, packed_->lower,
+                             packed_->upper);
+}
+double S21PackedMatrix::get_element_matrix_(int row, int col) const {
+  if ((row < 0 || row >= packed_->size) || (col < 0 || col >= packed_->size)) {
+    throw std::runtime_error("Index is outside the matrix");
+  }
+  return s21_packed_get(packed_, row, col);
+}
+void S21PackedMatrix::set_element_matrix_(int row, int col, double element) {
+  if ((row < 0 || row >= packed_->size) || (col < 0 || col >= packed_->size)) {
+    throw std::runtime_error("Index is outside the matrix");
+  }
+  double* stored = s21_packed_at(packed_, row, col);
+  if (stored != nullptr) {
+    *stored = element;
+  } else if (element != 0) {
+    throw std::runtime_error("Index is outside the matrix structure");
+  }
+}
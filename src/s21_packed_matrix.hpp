@@ -0,0 +1,63 @@
+#ifndef S21_PACKED_MATRIX_H_
+#define S21_PACKED_MATRIX_H_
+
+#include <cstddef>
+
+#include "s21_matrix_oop.hpp"
+
+#pragma once
+
+enum class S21Structure {
+  kSymmetric = S21_SYMMETRIC,
+  kUpperTriangular = S21_UPPER_TRIANGULAR,
+  kLowerTriangular = S21_LOWER_TRIANGULAR,
+  kDiagonal = S21_DIAGONAL,
+  kBanded = S21_BANDED
+};
+
+// Square matrix with a known structure keeping only the elements the structure
+// allows: n(n+1)/2 for symmetric and triangular, n for diagonal and
+// n(lower + upper + 1) for banded (lower = upper = 1 is tridiagonal).
+class S21PackedMatrix {
+ private:
+  packed_t* packed_;
+
+ public:
+  S21PackedMatrix(int size, S21Structure structure, int lower = 0,
+                  int upper = 0);
+  S21PackedMatrix(const S21Matrix& dense, S21Structure structure,
+                  int lower = 0, int upper = 0);
+  S21PackedMatrix(const S21PackedMatrix& other);
+  S21PackedMatrix(S21PackedMatrix&& other) noexcept;
+  ~S21PackedMatrix();
+
+  // A * A^T, or A^T * A when transpose is set, as a packed symmetric matrix.
+  static S21PackedMatrix Syrk(const S21Matrix& a, bool transpose = false);
+
+  S21Matrix ToDense() const;
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  void MulNumber(const double num);
+  S21PackedMatrix Transpose() const;
+  double Determinant() const;
+  S21Matrix Solve(const S21Matrix& b) const;
+
+  S21PackedMatrix operator+(const S21PackedMatrix& other) const;
+  S21PackedMatrix operator-(const S21PackedMatrix& other) const;
+  S21Matrix operator*(const S21Matrix& other) const;
+  S21PackedMatrix operator*(const double num) const;
+  S21PackedMatrix& operator=(const S21PackedMatrix& other);
+  S21PackedMatrix& operator=(S21PackedMatrix&& other) noexcept;
+
+  int get_size() const;
+  S21Structure get_structure() const;
+  int get_lower_bandwidth() const;
+  int get_upper_bandwidth() const;
+  std::size_t get_stored_elements() const;
+  double get_element_matrix_(int row, int col) const;
+  void set_element_matrix_(int row, int col, double element);
+
+ private:
+  S21PackedMatrix Combine(const S21PackedMatrix& other, double sign) const;
+};
+
+#endif  // S21_PACKED_MATRIX_H_
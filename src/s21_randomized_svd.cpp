@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_metrics.hpp"
+
+namespace {
+
+// Replaces the columns of y with an orthonormal basis of their span.
+void Orthonormalize(S21Matrix& y) {
+  S21Matrix r;
+  y.QrDecomposition(y, r);
+}
+
+}  // namespace
+
+// Halko, Martinsson and Tropp: Y = (A A^T)^q A * Omega for a Gaussian Omega,
+// Q = orth(Y), then the small B = Q^T A is decomposed exactly. Every step is a
+// GEMM or a blocked QR on panels with rank + oversampling columns.
+void S21Matrix::RandomizedSvd(int rank, int oversampling, int power_iterations,
+                              S21Matrix& u, std::vector<double>& s,
+                              S21Matrix& vt, unsigned seed) const {
+  int smallest = std::min(rows_, cols_);
+  if (rank <= 0 || rank > smallest || oversampling < 0 || power_iterations < 0)
+    throw std::runtime_error("Incorrect rank");
+  int samples = std::min(rank + oversampling, smallest);
+  S21OpScope scope(S21Op::kRandomizedSvd, rows_, cols_,
+                   2.0 * rows_ * cols_ * samples * (2.0 * power_iterations + 2),
+                   8.0 * rows_ * cols_ * (2.0 * power_iterations + 2));
+  S21Matrix omega(cols_, samples);
+  std::mt19937_64 generator(seed);
+  std::normal_distribution<double> normal;
+  for (int i = 0; i < cols_; i++) {
+    for (int j = 0; j < samples; j++) {
+      omega.matrix_->matrix[i][j] = normal(generator);
+    }
+  }
+  S21Matrix q(rows_, samples);
+  q.Gemm(*this, omega);
+  Orthonormalize(q);
+  for (int i = 0; i < power_iterations; i++) {
+    omega.Gemm(*this, q, 1.0, 0.0, true);
+    Orthonormalize(omega);
+    q.Gemm(*this, omega);
+    Orthonormalize(q);
+  }
+  S21Matrix b(samples, cols_);
+  b.Gemm(q, *this, 1.0, 0.0, true);
+  S21Matrix v(samples, samples);
+  std::vector<double> sigma(samples);
+  s21_jacobi_svd(b.matrix_, v.matrix_, sigma.data());
+  std::vector<int> order(samples);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](int x, int y) { return sigma[x] > sigma[y]; });
+  S21Matrix left(rows_, samples);
+  left.Gemm(q, v);
+  u = S21Matrix(rows_, rank);
+  vt = S21Matrix(rank, cols_);
+  s.resize(rank);
+  for (int k = 0; k < rank; k++) {
+    int source = order[k];
+    s[k] = sigma[source];
+    for (int i = 0; i < rows_; i++) {
+      u.matrix_->matrix[i][k] = left.matrix_->matrix[i][source];
+    }
+    for (int j = 0; j < cols_; j++) {
+      vt.matrix_->matrix[k][j] = b.matrix_->matrix[source][j];
+    }
+  }
+}
@@ -0,0 +1,75 @@
+#include <cmath>
+
+#include "s21_matrix_oop.hpp"
+#include "s21_metrics.hpp"
+
+// Householder reduction to tridiagonal form (blocked, the trailing updates
+// are GEMMs), then implicit QL for the whole spectrum or bisection with
+// inverse iteration for a range of indices. Eigenvectors of T are mapped
+// back with the blocked reflectors of the reduction.
+void S21Matrix::SymmetricEigen(std::vector<double>* values, S21Matrix* vectors,
+                               int first, int last) const {
+  if (rows_ != cols_) throw std::runtime_error("The matrix is not square");
+  double scale = 0;
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      scale = std::fmax(scale, std::fabs(matrix_->matrix[i][j]));
+    }
+  }
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < i; j++) {
+      if (std::fabs(matrix_->matrix[i][j] - matrix_->matrix[j][i]) >
+          1e-12 * scale)
+        throw std::runtime_error("The matrix is not symmetric");
+    }
+  }
+  if (last < 0) last = rows_ - 1;
+  if (first < 0 || first > last || last >= rows_)
+    throw std::runtime_error("Index is outside the matrix");
+  int n = rows_, count = last - first + 1;
+  double size = n, wanted = vectors != nullptr ? count : 0;
+  S21OpScope scope(S21Op::kSymmetricEigen, rows_, cols_,
+                   4.0 / 3.0 * size * size * size + 2.0 * size * size * wanted,
+                   16.0 * size * size + 8.0 * size * wanted);
+  S21Matrix reduced(*this);
+  reduced.Detach();
+  std::vector<double> d(n), e(n), tau(n);
+  S21Memory::Check(
+      s21_tridiagonalize(reduced.matrix_, d.data(), e.data(), tau.data()));
+  int error = OK;
+  scope.Algorithm(count == n ? "ql" : "bisection");
+  if (count == n) {
+    if (vectors != nullptr) {
+      *vectors = S21Matrix(n, n);
+      for (int i = 0; i < n; i++) vectors->matrix_->matrix[i][i] = 1.0;
+    }
+    error = s21_tridiagonal_ql(d.data(), e.data(), n,
+                               vectors ? vectors->matrix_ : nullptr);
+    values->assign(d.begin(), d.end());
+  } else {
+    values->resize(count);
+    s21_tridiagonal_bisect(d.data(), e.data(), n, first, last, values->data());
+    if (vectors != nullptr) {
+      *vectors = S21Matrix(n, count);
+      S21Memory::Check(s21_tridiagonal_inverse_iteration(
+          d.data(), e.data(), n, values->data(), count, vectors->matrix_));
+    }
+  }
+  if (error == CALC_ERROR)
+    throw std::runtime_error("The eigenvalue iteration did not converge");
+  if (vectors != nullptr) {
+    S21Memory::Check(s21_tridiagonal_back_transform(
+        reduced.matrix_, tau.data(), vectors->matrix_));
+  }
+}
+
+std::vector<double> S21Matrix::SymmetricEigenvalues(int first, int last) const {
+  std::vector<double> values;
+  SymmetricEigen(&values, nullptr, first, last);
+  return values;
+}
+
+void S21Matrix::SymmetricEigen(std::vector<double>& values, S21Matrix& vectors,
+                               int first, int last) const {
+  SymmetricEigen(&values, &vectors, first, last);
+}
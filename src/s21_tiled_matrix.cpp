@@ -0,0 +1,497 @@
+#include "s21_tiled_matrix.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'T', 'I', 'L', 'E', 'S'};
+constexpr std::uint32_t kVersion = 1;
+constexpr off_t kHeaderBytes = 64;
+constexpr std::size_t kMinimumCacheTiles = 4;
+
+struct FileHeader {
+  char magic[8];
+  std::uint32_t version, tile;
+  std::int64_t rows, cols;
+  char reserved[32];
+};
+
+static_assert(sizeof(FileHeader) == kHeaderBytes, "the header is 64 bytes");
+
+int TilesOf(int size, int tile) { return (size + tile - 1) / tile; }
+
+}  // namespace
+
+// Tiles of one file in memory. Pinned tiles stay put; the others are
+// evicted least recently used first, dirty ones through the write queue,
+// which counts against the capacity until the I/O thread has written them.
+// The same thread serves prefetch requests when a slot is free.
+class S21TileCache {
+ private:
+  struct Tile {
+    S21Matrix data;
+    int pins = 0;
+    bool dirty = false, loading = false;
+    std::list<long>::iterator position;
+  };
+
+  int file_, tile_;
+  std::size_t capacity_;
+  std::unordered_map<long, Tile> tiles_;
+  std::list<long> recent_;
+  std::deque<long> reads_;
+  std::deque<std::pair<long, S21Matrix>> writes_;
+  long writing_ = -1;
+  bool stop_ = false, failed_ = false;
+  S21TileStats stats_;
+  mutable std::mutex mutex_;
+  std::condition_variable changed_;
+  std::thread io_;
+
+  std::size_t Count() const {
+    return tiles_.size() + writes_.size() + (writing_ >= 0 ? 1 : 0);
+  }
+
+  bool Loading() const {
+    for (const auto& entry : tiles_) {
+      if (entry.second.loading) return true;
+    }
+    return false;
+  }
+
+  bool Pending(long index) const {
+    if (writing_ == index) return true;
+    for (const auto& write : writes_) {
+      if (write.first == index) return true;
+    }
+    return false;
+  }
+
+  off_t Offset(long index) const {
+    return kHeaderBytes + static_cast<off_t>(index) * tile_ * tile_ *
+                              static_cast<off_t>(sizeof(double));
+  }
+
+  bool Transfer(long index, const S21Matrix& data, bool write) {
+    char* bytes = reinterpret_cast<char*>(data.matrix_->matrix[0]);
+    std::size_t left = sizeof(double) * tile_ * tile_;
+    off_t offset = Offset(index);
+    while (left > 0) {
+      ssize_t done = write ? pwrite(file_, bytes, left, offset)
+                           : pread(file_, bytes, left, offset);
+      if (done <= 0) return false;
+      bytes += done;
+      offset += done;
+      left -= static_cast<std::size_t>(done);
+    }
+    return true;
+  }
+
+  // Frees a slot; without wait it gives up instead of waiting for writes
+  // and reads in flight.
+  bool Reserve(std::unique_lock<std::mutex>& lock, bool wait) {
+    while (Count() >= capacity_) {
+      auto victim = std::find_if(recent_.rbegin(), recent_.rend(), [&](long i) {
+        const Tile& tile = tiles_.at(i);
+        return tile.pins == 0 && !tile.loading;
+      });
+      if (victim != recent_.rend()) {
+        long index = *victim;
+        Tile& tile = tiles_.at(index);
+        if (tile.dirty) {
+          writes_.emplace_back(index, std::move(tile.data));
+          changed_.notify_all();
+        }
+        recent_.erase(tile.position);
+        tiles_.erase(index);
+      } else if (!wait) {
+        return false;
+      } else if (writes_.empty() && writing_ < 0 && !Loading()) {
+        throw std::runtime_error("All cached tiles are in use");
+      } else {
+        changed_.wait(lock);
+      }
+    }
+    return true;
+  }
+
+  Tile& Insert(long index, bool loading) {
+    Tile& tile = tiles_[index];
+    tile.data = S21Matrix(tile_, tile_);
+    tile.loading = loading;
+    recent_.push_front(index);
+    tile.position = recent_.begin();
+    return tile;
+  }
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      changed_.wait(lock, [&] {
+        return stop_ || !writes_.empty() || !reads_.empty();
+      });
+      if (!writes_.empty()) {
+        std::pair<long, S21Matrix> write = std::move(writes_.front());
+        writes_.pop_front();
+        writing_ = write.first;
+        lock.unlock();
+        bool written = Transfer(write.first, write.second, true);
+        lock.lock();
+        writing_ = -1;
+        stats_.writes++;
+        failed_ = failed_ || !written;
+        changed_.notify_all();
+      } else if (stop_) {
+        break;
+      } else {
+        long index = reads_.front();
+        reads_.pop_front();
+        if (tiles_.count(index) || Pending(index) || !Reserve(lock, false))
+          continue;
+        Tile& tile = Insert(index, true);
+        lock.unlock();
+        bool read = Transfer(index, tile.data, false);
+        lock.lock();
+        if (read) {
+          tile.loading = false;
+          stats_.reads++;
+          stats_.prefetched++;
+        } else {
+          recent_.erase(tile.position);
+          tiles_.erase(index);
+        }
+        changed_.notify_all();
+      }
+    }
+  }
+
+ public:
+  S21TileCache(int file, int tile, std::size_t capacity)
+      : file_(file),
+        tile_(tile),
+        capacity_(std::max(capacity, kMinimumCacheTiles)),
+        io_([this] { Run(); }) {}
+
+  ~S21TileCache() {
+    try {
+      Flush();
+    } catch (const std::exception&) {
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    changed_.notify_all();
+    io_.join();
+    close(file_);
+  }
+
+  // The tile, held in memory until Unpin. A fresh tile is not read: it
+  // starts zeroed and dirty, for results that overwrite it.
+  S21Matrix& Pin(long index, bool fresh) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      auto found = tiles_.find(index);
+      if (found != tiles_.end() && found->second.loading) {
+        changed_.wait(lock);
+      } else if (found != tiles_.end()) {
+        Tile& tile = found->second;
+        stats_.hits++;
+        tile.pins++;
+        recent_.splice(recent_.begin(), recent_, tile.position);
+        if (fresh) {
+          std::fill_n(tile.data.matrix_->matrix[0], tile_ * tile_, 0.0);
+          tile.dirty = true;
+        }
+        return tile.data;
+      } else if (Pending(index)) {
+        changed_.wait(lock);
+      } else if (Count() >= capacity_) {
+        Reserve(lock, true);
+      } else {
+        break;
+      }
+    }
+    stats_.misses++;
+    Tile& tile = Insert(index, !fresh);
+    tile.pins = 1;
+    tile.dirty = fresh;
+    if (!fresh) {
+      lock.unlock();
+      bool read = Transfer(index, tile.data, false);
+      lock.lock();
+      stats_.reads++;
+      changed_.notify_all();
+      if (!read) {
+        recent_.erase(tile.position);
+        tiles_.erase(index);
+        throw std::runtime_error("Cannot read a tile");
+      }
+      tile.loading = false;
+    }
+    return tile.data;
+  }
+
+  void Unpin(long index, bool dirty) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Tile& tile = tiles_.at(index);
+    tile.pins--;
+    tile.dirty = tile.dirty || dirty;
+  }
+
+  void Prefetch(long index) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (tiles_.count(index) ||
+          std::find(reads_.begin(), reads_.end(), index) != reads_.end())
+        return;
+      reads_.push_back(index);
+    }
+    changed_.notify_all();
+  }
+
+  void Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [&] { return writes_.empty() && writing_ < 0; });
+    for (auto& entry : tiles_) {
+      Tile& tile = entry.second;
+      if (tile.dirty && !tile.loading) {
+        failed_ = failed_ || !Transfer(entry.first, tile.data, true);
+        stats_.writes++;
+        tile.dirty = false;
+      }
+    }
+    if (failed_) throw std::runtime_error("Cannot write a tile");
+  }
+
+  S21TileStats Stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+};
+
+S21TiledMatrix::S21TiledMatrix(int file, int rows, int cols, int tile,
+                               std::size_t cache_tiles)
+    : rows_(rows),
+      cols_(cols),
+      tile_(tile),
+      cache_tiles_(cache_tiles),
+      cache_(new S21TileCache(file, tile, cache_tiles)) {}
+
+S21TiledMatrix::S21TiledMatrix(const std::string& path, int rows, int cols,
+                               int tile, std::size_t cache_tiles)
+    : rows_(rows), cols_(cols), tile_(tile), cache_tiles_(cache_tiles) {
+  if (rows <= 0 || cols <= 0 || tile <= 0 || tile > kMaxTile)
+    throw std::runtime_error("Incorrect matrix");
+  int file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file < 0) throw std::runtime_error("Cannot write " + path);
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.tile = static_cast<std::uint32_t>(tile);
+  header.rows = rows;
+  header.cols = cols;
+  off_t tiles = static_cast<off_t>(TilesOf(rows, tile)) * TilesOf(cols, tile);
+  if (pwrite(file, &header, sizeof(header), 0) !=
+          static_cast<ssize_t>(sizeof(header)) ||
+      ftruncate(file, kHeaderBytes + tiles * tile * tile *
+                                         static_cast<off_t>(sizeof(double))) !=
+          0) {
+    close(file);
+    throw std::runtime_error("Cannot write " + path);
+  }
+  cache_.reset(new S21TileCache(file, tile, cache_tiles));
+}
+
+S21TiledMatrix::S21TiledMatrix(S21TiledMatrix&& other) noexcept = default;
+
+S21TiledMatrix& S21TiledMatrix::operator=(S21TiledMatrix&& other) noexcept =
+    default;
+
+S21TiledMatrix::~S21TiledMatrix() = default;
+
+S21TiledMatrix S21TiledMatrix::Open(const std::string& path,
+                                    std::size_t cache_tiles) {
+  int file = open(path.c_str(), O_RDWR);
+  if (file < 0) throw std::runtime_error("Cannot read " + path);
+  FileHeader header{};
+  if (pread(file, &header, sizeof(header), 0) !=
+          static_cast<ssize_t>(sizeof(header)) ||
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.tile == 0 ||
+      header.tile > static_cast<std::uint32_t>(kMaxTile) ||
+      header.rows <= 0 || header.rows > INT_MAX || header.cols <= 0 ||
+      header.cols > INT_MAX) {
+    close(file);
+    throw std::runtime_error("Not a tiled matrix file: " + path);
+  }
+  return S21TiledMatrix(file, static_cast<int>(header.rows),
+                        static_cast<int>(header.cols),
+                        static_cast<int>(header.tile), cache_tiles);
+}
+
+long S21TiledMatrix::Index(int tile_row, int tile_col) const {
+  return static_cast<long>(tile_row) * TilesOf(cols_, tile_) + tile_col;
+}
+
+S21TiledMatrix S21TiledMatrix::FromMatrix(const S21Matrix& matrix,
+                                          const std::string& path, int tile,
+                                          std::size_t cache_tiles) {
+  S21TiledMatrix result(path, matrix.get_rows(), matrix.get_cols(), tile,
+                        cache_tiles);
+  for (int ti = 0; ti < TilesOf(result.rows_, tile); ti++) {
+    for (int tj = 0; tj < TilesOf(result.cols_, tile); tj++) {
+      S21Matrix& block = result.cache_->Pin(result.Index(ti, tj), true);
+      int rows = std::min(tile, result.rows_ - ti * tile);
+      int cols = std::min(tile, result.cols_ - tj * tile);
+      for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+          block(i, j) =
+              matrix.get_element_matrix_(ti * tile + i, tj * tile + j);
+        }
+      }
+      result.cache_->Unpin(result.Index(ti, tj), true);
+    }
+  }
+  return result;
+}
+
+S21Matrix S21TiledMatrix::ToMatrix() {
+  S21Matrix result(rows_, cols_);
+  int tile_rows = TilesOf(rows_, tile_), tile_cols = TilesOf(cols_, tile_);
+  for (long index = 0; index < static_cast<long>(tile_rows) * tile_cols;
+       index++) {
+    if (index + 1 < static_cast<long>(tile_rows) * tile_cols)
+      cache_->Prefetch(index + 1);
+    const S21Matrix& block = cache_->Pin(index, false);
+    int ti = static_cast<int>(index / tile_cols);
+    int tj = static_cast<int>(index % tile_cols);
+    int rows = std::min(tile_, rows_ - ti * tile_);
+    int cols = std::min(tile_, cols_ - tj * tile_);
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        result.set_element_matrix_(ti * tile_ + i, tj * tile_ + j,
+                                   block.get_element_matrix_(i, j));
+      }
+    }
+    cache_->Unpin(index, false);
+  }
+  return result;
+}
+
+// C(i, j) accumulates A(i, k) * B(k, j) over k while the next pair of
+// tiles is read ahead; tiles of C are written behind once complete.
+S21TiledMatrix S21TiledMatrix::MulMatrix(S21TiledMatrix& other,
+                                         const std::string& path) {
+  if (cols_ != other.rows_)
+    throw std::runtime_error(
+        "The number of columns of the first matrix is not equal to the number "
+        "of rows of the second matrix");
+  if (tile_ != other.tile_) throw std::runtime_error("Different tile sizes");
+  S21TiledMatrix result(path, rows_, other.cols_, tile_, cache_tiles_);
+  int tile_rows = TilesOf(rows_, tile_), inner = TilesOf(cols_, tile_),
+      tile_cols = TilesOf(other.cols_, tile_);
+  for (int i = 0; i < tile_rows; i++) {
+    for (int j = 0; j < tile_cols; j++) {
+      S21Matrix& c = result.cache_->Pin(result.Index(i, j), true);
+      for (int k = 0; k < inner; k++) {
+        int next_k = k + 1 < inner ? k + 1 : 0;
+        int next_j = k + 1 < inner ? j : j + 1;
+        if (next_j < tile_cols) {
+          cache_->Prefetch(Index(i, next_k));
+          other.cache_->Prefetch(other.Index(next_k, next_j));
+        }
+        const S21Matrix& a = cache_->Pin(Index(i, k), false);
+        const S21Matrix& b = other.cache_->Pin(other.Index(k, j), false);
+        c.Gemm(a, b, 1.0, 1.0);
+        cache_->Unpin(Index(i, k), false);
+        other.cache_->Unpin(other.Index(k, j), false);
+      }
+      result.cache_->Unpin(result.Index(i, j), true);
+    }
+  }
+  result.Flush();
+  return result;
+}
+
+S21TiledMatrix S21TiledMatrix::Transpose(const std::string& path) {
+  S21TiledMatrix result(path, cols_, rows_, tile_, cache_tiles_);
+  int tile_rows = TilesOf(rows_, tile_), tile_cols = TilesOf(cols_, tile_);
+  for (int i = 0; i < tile_rows; i++) {
+    for (int j = 0; j < tile_cols; j++) {
+      if (j + 1 < tile_cols) cache_->Prefetch(Index(i, j + 1));
+      if (j + 1 == tile_cols && i + 1 < tile_rows)
+        cache_->Prefetch(Index(i + 1, 0));
+      const S21Matrix& a = cache_->Pin(Index(i, j), false);
+      S21Matrix& r = result.cache_->Pin(result.Index(j, i), true);
+      r = a.Transpose();
+      result.cache_->Unpin(result.Index(j, i), true);
+      cache_->Unpin(Index(i, j), false);
+    }
+  }
+  result.Flush();
+  return result;
+}
+
+S21TiledMatrix S21TiledMatrix::SumMatrix(S21TiledMatrix& other,
+                                         const std::string& path) {
+  if (rows_ != other.rows_ || cols_ != other.cols_)
+    throw std::runtime_error("Different matrix dimensions");
+  if (tile_ != other.tile_) throw std::runtime_error("Different tile sizes");
+  S21TiledMatrix result(path, rows_, cols_, tile_, cache_tiles_);
+  long tiles = static_cast<long>(TilesOf(rows_, tile_)) * TilesOf(cols_, tile_);
+  for (long index = 0; index < tiles; index++) {
+    if (index + 1 < tiles) {
+      cache_->Prefetch(index + 1);
+      other.cache_->Prefetch(index + 1);
+    }
+    const S21Matrix& a = cache_->Pin(index, false);
+    const S21Matrix& b = other.cache_->Pin(index, false);
+    S21Matrix& r = result.cache_->Pin(index, true);
+    r.SumMatrix(a);
+    r.SumMatrix(b);
+    result.cache_->Unpin(index, true);
+    other.cache_->Unpin(index, false);
+    cache_->Unpin(index, false);
+  }
+  result.Flush();
+  return result;
+}
+
+double S21TiledMatrix::Get(int row, int col) {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::runtime_error("Index is outside the matrix");
+  long index = Index(row / tile_, col / tile_);
+  double element =
+      cache_->Pin(index, false).get_element_matrix_(row % tile_, col % tile_);
+  cache_->Unpin(index, false);
+  return element;
+}
+
+void S21TiledMatrix::Set(int row, int col, double element) {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_)
+    throw std::runtime_error("Index is outside the matrix");
+  long index = Index(row / tile_, col / tile_);
+  cache_->Pin(index, false)(row % tile_, col % tile_) = element;
+  cache_->Unpin(index, true);
+}
+
+void S21TiledMatrix::Flush() { cache_->Flush(); }
+
+int S21TiledMatrix::get_rows() const { return rows_; }
+int S21TiledMatrix::get_cols() const { return cols_; }
+int S21TiledMatrix::get_tile() const { return tile_; }
+
+S21TileStats S21TiledMatrix::Stats() const { return cache_->Stats(); }
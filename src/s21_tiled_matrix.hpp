@@ -0,0 +1,78 @@
+#ifndef S21_TILED_MATRIX_H_
+#define S21_TILED_MATRIX_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "s21_matrix_oop.hpp"
+
+#pragma once
+
+class S21TileCache;
+
+struct S21TileStats {
+  std::uint64_t hits = 0, misses = 0, prefetched = 0;
+  std::uint64_t reads = 0, writes = 0;
+};
+
+// Out-of-core matrix kept in a file as tile x tile blocks (edge tiles are
+// zero padded), for matrices that do not fit in memory. At most
+// cache_tiles tiles are held in memory, least recently used first out. A
+// background thread reads the tiles an operation will need next and
+// writes evicted dirty tiles back while the caller computes.
+//
+// File: a 64-byte header ("S21TILES", uint32 version 1, uint32 tile, int64
+// rows, int64 cols), then the tiles row by row, each row-major float64.
+class S21TiledMatrix {
+ private:
+  int rows_, cols_, tile_;
+  std::size_t cache_tiles_;
+  std::unique_ptr<S21TileCache> cache_;
+
+  S21TiledMatrix(int file, int rows, int cols, int tile,
+                 std::size_t cache_tiles);
+  long Index(int tile_row, int tile_col) const;
+
+ public:
+  static constexpr int kDefaultTile = 512;
+  // Largest tile whose tile * tile elements an int counts.
+  static constexpr int kMaxTile = 46340;
+  static constexpr std::size_t kDefaultCacheTiles = 64;
+
+  // A zero matrix in a new file at path.
+  S21TiledMatrix(const std::string& path, int rows, int cols,
+                 int tile = kDefaultTile,
+                 std::size_t cache_tiles = kDefaultCacheTiles);
+  S21TiledMatrix(S21TiledMatrix&& other) noexcept;
+  S21TiledMatrix& operator=(S21TiledMatrix&& other) noexcept;
+  S21TiledMatrix(const S21TiledMatrix&) = delete;
+  S21TiledMatrix& operator=(const S21TiledMatrix&) = delete;
+  // Writes the dirty tiles back; the file stays.
+  ~S21TiledMatrix();
+
+  static S21TiledMatrix Open(const std::string& path,
+                             std::size_t cache_tiles = kDefaultCacheTiles);
+  static S21TiledMatrix FromMatrix(const S21Matrix& matrix,
+                                   const std::string& path,
+                                   int tile = kDefaultTile,
+                                   std::size_t cache_tiles =
+                                       kDefaultCacheTiles);
+  S21Matrix ToMatrix();
+
+  // The results go to new files at path, cached like this matrix.
+  S21TiledMatrix MulMatrix(S21TiledMatrix& other, const std::string& path);
+  S21TiledMatrix Transpose(const std::string& path);
+  S21TiledMatrix SumMatrix(S21TiledMatrix& other, const std::string& path);
+
+  double Get(int row, int col);
+  void Set(int row, int col, double element);
+  void Flush();
+
+  int get_rows() const;
+  int get_cols() const;
+  int get_tile() const;
+  S21TileStats Stats() const;
+};
+
+#endif  // S21_TILED_MATRIX_H_
@@ -0,0 +1,186 @@
+#include "s21_trace.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix/s21_matrix.h"
+
+namespace {
+
+// Single-producer ring: only the owning thread writes events and head,
+// readers take the window [head - capacity, head) and drop whatever the
+// producer overwrote meanwhile.
+struct Ring {
+  std::vector<S21TraceEvent> events;
+  std::atomic<std::uint64_t> head{0}, flushed{0};
+  // Set when the owning thread has exited; the next new thread with the
+  // same capacity takes the ring over instead of allocating one. tid is
+  // that of the owner and stamped on its events, so events the previous
+  // owner left in the ring keep their own thread.
+  std::atomic<bool> finished{false};
+  int tid;
+
+  Ring(std::size_t capacity, int id) : events(capacity), tid(id) {}
+
+  void Push(const S21TraceEvent& event) {
+    std::uint64_t position = head.load(std::memory_order_relaxed);
+    events[position & (events.size() - 1)] = event;
+    head.store(position + 1, std::memory_order_release);
+  }
+};
+
+std::mutex registry_mutex;
+std::vector<std::shared_ptr<Ring>> registry;
+std::atomic<std::size_t> ring_capacity{S21Trace::kDefaultCapacity};
+int next_tid = 1;
+
+struct RingOwner {
+  std::shared_ptr<Ring> ring;
+
+  ~RingOwner() {
+    if (ring) ring->finished.store(true, std::memory_order_release);
+  }
+};
+
+// Rings outlive their threads in the registry, so spans of finished
+// workers still reach the next Flush, which drops them afterwards. Rings
+// are reused, so short-lived threads cost no more memory than the most
+// threads tracing at once.
+Ring& LocalRing() {
+  thread_local RingOwner owner;
+  if (!owner.ring) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::size_t capacity = ring_capacity.load();
+    for (const std::shared_ptr<Ring>& ring : registry) {
+      if (ring->events.size() == capacity &&
+          ring->finished.load(std::memory_order_acquire)) {
+        ring->finished.store(false, std::memory_order_relaxed);
+        ring->tid = next_tid++;
+        owner.ring = ring;
+        break;
+      }
+    }
+    if (!owner.ring) {
+      owner.ring = std::make_shared<Ring>(capacity, next_tid++);
+      registry.push_back(owner.ring);
+    }
+  }
+  return *owner.ring;
+}
+
+// Drops the rings of finished threads whose events have all been flushed.
+void Reap() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  std::vector<std::shared_ptr<Ring>> kept;
+  for (std::shared_ptr<Ring>& ring : registry) {
+    if (!ring->finished.load() || ring->flushed.load() != ring->head.load())
+      kept.push_back(std::move(ring));
+  }
+  registry.swap(kept);
+}
+
+std::int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Hook(const char* name, int begin, int rows, int columns) {
+  S21Trace::Record(name, begin ? 'B' : 'E', rows, columns);
+}
+
+// Writes the event, preceded by the name of its thread when named does not
+// hold that thread yet.
+void WriteEvent(std::ostringstream& out, const S21TraceEvent& event,
+                std::set<int>& named, bool& first) {
+  if (named.insert(event.tid).second) {
+    out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\""
+        << ",\"pid\":" << getpid() << ",\"tid\":" << event.tid
+        << ",\"args\":{\"name\":\"thread " << event.tid << "\"}}";
+    first = false;
+  }
+  out << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name
+      << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << event.time_ns / 1e3
+      << ",\"pid\":" << getpid() << ",\"tid\":" << event.tid
+      << ",\"args\":{\"rows\":" << event.rows << ",\"cols\":" << event.cols;
+  if (event.algorithm) out << ",\"algorithm\":\"" << event.algorithm << "\"";
+  out << "}}";
+  first = false;
+}
+
+// Trace JSON of every ring; with consume the events are marked flushed.
+std::string Collect(bool consume) {
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    rings = registry;
+  }
+  std::ostringstream out;
+  out.precision(15);
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  std::set<int> named;
+  for (const std::shared_ptr<Ring>& ring : rings) {
+    std::size_t capacity = ring->events.size();
+    std::uint64_t head = ring->head.load(std::memory_order_acquire);
+    std::uint64_t start = ring->flushed.load();
+    if (head - start > capacity) start = head - capacity;
+    std::vector<S21TraceEvent> copy;
+    for (std::uint64_t i = start; i < head; i++)
+      copy.push_back(ring->events[i & (capacity - 1)]);
+    std::uint64_t after = ring->head.load(std::memory_order_acquire);
+    std::uint64_t valid = after > capacity ? after - capacity : 0;
+    if (consume) ring->flushed.store(head);
+    for (std::uint64_t i = start; i < head; i++) {
+      if (i >= valid) WriteEvent(out, copy[i - start], named, first);
+    }
+  }
+  out << "\n]}\n";
+  if (consume) Reap();
+  return out.str();
+}
+
+}  // namespace
+
+void S21Trace::Enable(bool enabled, std::size_t capacity) {
+  std::size_t rounded = 1;
+  while (rounded < capacity) rounded <<= 1;
+  ring_capacity.store(rounded);
+  enabled_.store(enabled);
+  s21_trace_set_hook(enabled ? Hook : NULL);
+}
+
+bool S21Trace::Enabled() { return enabled_.load(); }
+
+void S21Trace::Record(const char* name, char phase, int rows, int cols,
+                      const char* algorithm) {
+  if (!enabled_.load(std::memory_order_relaxed)) return;
+  Ring& ring = LocalRing();
+  ring.Push({name, algorithm, NowNs(), rows, cols, phase, ring.tid});
+}
+
+void S21Trace::Flush(const std::string& path) {
+  std::string json = Collect(true);
+  std::ofstream file(path);
+  file << json;
+  if (!file) throw std::runtime_error("Cannot write " + path);
+}
+
+std::string S21Trace::Json() { return Collect(false); }
+
+void S21Trace::Clear() {
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (const std::shared_ptr<Ring>& ring : registry)
+      ring->flushed.store(ring->head.load());
+  }
+  Reap();
+}
@@ -0,0 +1,51 @@
+#ifndef S21_TRACE_H_
+#define S21_TRACE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#pragma once
+
+// One begin ('B') or end ('E') event of a span. name and algorithm point
+// to string literals, algorithm is set on end events only. tid numbers the
+// thread that recorded it, in the order threads started tracing.
+struct S21TraceEvent {
+  const char* name;
+  const char* algorithm;
+  std::int64_t time_ns;
+  int rows, cols;
+  char phase;
+  int tid;
+};
+
+// Opt-in timeline of public operations and internal phases. Every thread
+// writes into its own ring buffer without locks, the oldest events are
+// overwritten once it is full. Flush writes the Chrome trace-event JSON
+// that chrome://tracing and ui.perfetto.dev open; events a thread
+// overwrites while Flush reads them are dropped. Rings of finished threads
+// are reused by new ones and dropped once flushed.
+class S21Trace {
+  friend class S21OpScope;
+
+ private:
+  static inline std::atomic<bool> enabled_{false};
+
+ public:
+  static constexpr std::size_t kDefaultCapacity = std::size_t{1} << 16;
+
+  // capacity is the number of events per thread, rounded up to a power of
+  // two; it applies to threads that have not traced anything yet.
+  static void Enable(bool enabled = true,
+                     std::size_t capacity = kDefaultCapacity);
+  static bool Enabled();
+  static void Record(const char* name, char phase, int rows, int cols,
+                     const char* algorithm = nullptr);
+  // Writes the events recorded since the last Flush or Clear.
+  static void Flush(const std::string& path);
+  static std::string Json();
+  static void Clear();
+};
+
+#endif  // S21_TRACE_H_
@@ -0,0 +1,150 @@
+#include "s21_tuner.hpp"
+
+#include <omp.h>
+
+#include <chrono>
+#include <climits>
+#include <filesystem>
+#include <memory>
+#include <random>
+
+#include "s21_backend.hpp"
+#include "s21_memory.hpp"
+
+namespace {
+
+S21Matrix RandomMatrix(int rows, int cols) {
+  std::mt19937_64 generator(rows * 31 + cols);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) result(i, j) = uniform(generator);
+  }
+  return result;
+}
+
+}  // namespace
+
+S21Tuner::S21Tuner(std::ostream* log, int repeats)
+    : log_(log), repeats_(repeats) {
+  s21_tuning_defaults(&tuning_);
+}
+
+// Best of repeats_ runs after one warm-up run, in seconds.
+double S21Tuner::Time(const std::function<void()>& kernel) const {
+  kernel();
+  double best = 0;
+  for (int i = 0; i < repeats_; i++) {
+    auto start = std::chrono::steady_clock::now();
+    kernel();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (i == 0 || elapsed.count() < best) best = elapsed.count();
+  }
+  return best;
+}
+
+void S21Tuner::Publish() { S21Memory::Check(s21_tuning_publish(&tuning_)); }
+
+// parameter points into tuning_.
+void S21Tuner::Pick(const char* name, int* parameter,
+                    const std::vector<int>& candidates,
+                    const std::function<void()>& kernel) {
+  int best = *parameter;
+  double best_time = Time(kernel);
+  for (int candidate : candidates) {
+    *parameter = candidate;
+    Publish();
+    double time = Time(kernel);
+    if (time < best_time) {
+      best = candidate;
+      best_time = time;
+    }
+  }
+  *parameter = best;
+  Publish();
+  if (log_ != nullptr) *log_ << name << " " << best << "\n";
+}
+
+// Smallest work (as measured by work(size)) at which the parallel kernel
+// beats the serial one; never parallel if it does not win at any of the
+// sizes or there is a single thread. prepare(size) allocates the operands
+// and returns the kernel to time.
+void S21Tuner::Crossover(
+    const char* name, long* threshold, const std::vector<int>& sizes,
+    const std::function<long(int)>& work,
+    const std::function<std::function<void()>(int)>& prepare) {
+  long crossover = LONG_MAX;
+  for (std::size_t i = 0;
+       omp_get_max_threads() > 1 && crossover == LONG_MAX && i < sizes.size();
+       i++) {
+    std::function<void()> kernel = prepare(sizes[i]);
+    *threshold = LONG_MAX;
+    Publish();
+    double serial = Time(kernel);
+    *threshold = 0;
+    Publish();
+    double parallel = Time(kernel);
+    if (parallel < serial) crossover = work(sizes[i]);
+  }
+  *threshold = crossover;
+  Publish();
+  if (log_ != nullptr) *log_ << name << " " << crossover << "\n";
+}
+
+s21_tuning_t S21Tuner::Run() {
+  S21BackendScope builtin("builtin");
+  s21_tuning_defaults(&tuning_);
+  Publish();
+  S21Matrix a = RandomMatrix(384, 384), b = RandomMatrix(384, 384);
+  auto multiply = [&] {
+    S21Matrix c(a);
+    c.MulMatrix(b);
+  };
+  Pick("gemm_kc", &tuning_.gemm_kc, {128, 192, 384, 512}, multiply);
+  Pick("gemm_mc", &tuning_.gemm_mc, {16, 32, 96, 128}, multiply);
+  Pick("gemm_nc", &tuning_.gemm_nc, {128, 256, 1024, 2048}, multiply);
+  Crossover(
+      "parallel_threshold", &tuning_.parallel_threshold,
+      {16, 24, 32, 48, 64, 96, 128, 192},
+      [](int size) { return static_cast<long>(size) * size * size; },
+      [](int size) -> std::function<void()> {
+        S21Matrix left = RandomMatrix(size, size);
+        S21Matrix right = RandomMatrix(size, size);
+        return [left, right] { left * right; };
+      });
+  S21Matrix wide = RandomMatrix(1024, 1024);
+  Pick("transpose_block", &tuning_.transpose_block, {8, 16, 64, 128},
+       [&] { wide.Transpose(); });
+  std::vector<double> x(1024, 1.0), y(1024);
+  Pick("gemv_chunk", &tuning_.gemv_chunk, {128, 256, 1024, 2048},
+       [&] { wide.Gemv(1.0, x, 0.0, y, true); });
+  Pick("qr_block", &tuning_.qr_block, {8, 16, 48, 64}, [&] {
+    S21Matrix q, r;
+    a.QrDecomposition(q, r);
+  });
+  Crossover(
+      "elementwise_threshold", &tuning_.elementwise_threshold,
+      {4, 16, 64, 256, 1024},
+      [](int rows) { return rows * 1024L; },
+      [](int rows) -> std::function<void()> {
+        auto sum = std::make_shared<S21Matrix>(RandomMatrix(rows, 1024));
+        S21Matrix term = RandomMatrix(rows, 1024);
+        return [sum, term] { sum->SumMatrix(term); };
+      });
+  return tuning_;
+}
+
+std::string S21Tuner::ProfilePath() {
+  char path[1024];
+  if (s21_tuning_path(path, sizeof(path)) != OK)
+    throw std::runtime_error("No place for the tuning profile");
+  return path;
+}
+
+void S21Tuner::Save(const s21_tuning_t& tuning, const std::string& path) {
+  std::filesystem::path parent = std::filesystem::path(path).parent_path();
+  if (!parent.empty()) std::filesystem::create_directories(parent);
+  if (s21_tuning_save(path.c_str(), &tuning) != OK)
+    throw std::runtime_error("Cannot write the tuning profile");
+}
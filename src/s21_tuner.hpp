@@ -0,0 +1,42 @@
+#ifndef S21_TUNER_H_
+#define S21_TUNER_H_
+
+#include <functional>
+#include <ostream>
+#include <string>
+
+#include "s21_matrix_oop.hpp"
+
+#pragma once
+
+// Microbenchmarks the built-in kernels (MulMatrix, Transpose, element-wise
+// sums, GEMV and QR) over candidate tile sizes and parallel crossovers on
+// the current machine. Every candidate is published with
+// s21_tuning_publish, so kernels running meanwhile on other threads see a
+// whole profile; Run() leaves the fastest parameters published and Save()
+// writes them as the profile loaded at the next startup.
+class S21Tuner {
+ private:
+  std::ostream* log_;
+  int repeats_;
+  s21_tuning_t tuning_;
+
+  double Time(const std::function<void()>& kernel) const;
+  void Publish();
+  void Pick(const char* name, int* parameter,
+            const std::vector<int>& candidates,
+            const std::function<void()>& kernel);
+  void Crossover(const char* name, long* threshold,
+                 const std::vector<int>& sizes,
+                 const std::function<long(int)>& work,
+                 const std::function<std::function<void()>(int)>& prepare);
+
+ public:
+  explicit S21Tuner(std::ostream* log = nullptr, int repeats = 3);
+  s21_tuning_t Run();
+
+  static std::string ProfilePath();
+  static void Save(const s21_tuning_t& tuning, const std::string& path);
+};
+
+#endif  // S21_TUNER_H_
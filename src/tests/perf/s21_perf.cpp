@@ -0,0 +1,317 @@
+// Performance regression harness: times a fixed set of workloads and
+// compares their median and 95th percentile with tests/perf/baseline.txt.
+//
+//   s21_perf [--record] [--baseline FILE] [--repetitions N] [--tolerance X]
+//
+// --record rewrites the baseline from this run instead of comparing. All
+// workloads run on the built-in backend with one thread, so the numbers
+// describe this library rather than the system BLAS or the scheduler.
+// Every run also times a reference kernel that uses no library code,
+// interleaved with the workloads, and workloads are compared relative to
+// it, so a baseline recorded on a slower or faster host of the same kind
+// still applies. The reference row reports the 10th percentile of its
+// samples in the median column: on a shared host a low percentile tracks
+// the speed of the machine and not the time other tenants take. A
+// baseline that cannot be read, or lists a workload this run lacks, fails
+// the run.
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "s21_backend.hpp"
+#include "s21_matrix_oop.hpp"
+
+namespace {
+
+constexpr int kWarmup = 3;
+constexpr int kReferenceSize = 128;
+constexpr int kReferenceSamples = 5;
+constexpr double kReferenceCentre = 0.1;
+constexpr std::size_t kStreamDoubles = std::size_t{1} << 20;
+const char* const kReference = "Reference";
+
+struct Workload {
+  std::string operation;
+  int size;
+  std::function<std::function<void()>(int)> prepare;
+};
+
+struct Summary {
+  double median, p95, mad;
+};
+
+S21Matrix Random(int rows, int cols, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) result(i, j) = uniform(generator);
+  }
+  return result;
+}
+
+S21Matrix Spd(int size) {
+  S21Matrix a = Random(size, size, 3);
+  S21Matrix result = a.Syrk();
+  for (int i = 0; i < size; i++) result(i, i) += size;
+  return result;
+}
+
+volatile double sink;
+
+// Naive product of two size x size arrays in cache plus a pass over 8 MB:
+// its time follows the compute and memory speed of the host and not this
+// library.
+std::function<void()> Reference(int size) {
+  auto a = std::make_shared<std::vector<double>>(size * size, 1.0 / 3.0);
+  auto c = std::make_shared<std::vector<double>>(size * size, 0.0);
+  auto stream = std::make_shared<std::vector<double>>(kStreamDoubles, 1.0);
+  return [a, c, stream, size] {
+    const std::vector<double>& x = *a;
+    std::vector<double>& y = *c;
+    std::fill(y.begin(), y.end(), 0.0);
+    for (int i = 0; i < size; i++) {
+      for (int k = 0; k < size; k++) {
+        double factor = x[i * size + k];
+        for (int j = 0; j < size; j++)
+          y[i * size + j] += factor * x[k * size + j];
+      }
+    }
+    for (double& value : *stream) value = 0.5 * value + 1.0;
+    sink = y[0] + stream->back();
+  };
+}
+
+// prepare(size) builds the operands once and returns the timed kernel.
+std::vector<Workload> Workloads() {
+  auto binary = [](auto kernel) {
+    return [kernel](int size) -> std::function<void()> {
+      auto a = std::make_shared<S21Matrix>(Random(size, size, 1));
+      auto b = std::make_shared<S21Matrix>(Random(size, size, 2));
+      return [a, b, kernel] { kernel(*a, *b); };
+    };
+  };
+  auto mul = binary([](S21Matrix& a, S21Matrix& b) { a * b; });
+  auto sum = binary([](S21Matrix& a, S21Matrix& b) { a.SumMatrix(b); });
+  auto number = binary([](S21Matrix& a, S21Matrix&) { a.MulNumber(-1.0); });
+  auto transpose = binary([](S21Matrix& a, S21Matrix&) { a.Transpose(); });
+  auto determinant =
+      binary([](S21Matrix& a, S21Matrix&) { a.Determinant(); });
+  auto qr = binary([](S21Matrix& a, S21Matrix&) {
+    S21Matrix q, r;
+    a.QrDecomposition(q, r);
+  });
+  auto cholesky = [](int size) -> std::function<void()> {
+    auto a = std::make_shared<S21Matrix>(Spd(size));
+    return [a] { a->Cholesky(); };
+  };
+  auto eigen = [](int size) -> std::function<void()> {
+    auto a = std::make_shared<S21Matrix>(Spd(size));
+    return [a] { a->SymmetricEigenvalues(); };
+  };
+  return {{"MulMatrix", 64, mul},        {"MulMatrix", 256, mul},
+          {"SumMatrix", 256, sum},       {"SumMatrix", 1024, sum},
+          {"MulNumber", 1024, number},   {"Transpose", 256, transpose},
+          {"Transpose", 1024, transpose}, {"Determinant", 7, determinant},
+          {"QrDecomposition", 256, qr},  {"Cholesky", 256, cholesky},
+          {"SymmetricEigen", 128, eigen}};
+}
+
+double Percentile(std::vector<double> samples, double fraction) {
+  std::sort(samples.begin(), samples.end());
+  double position = fraction * (samples.size() - 1);
+  std::size_t low = static_cast<std::size_t>(position);
+  std::size_t high = std::min(low + 1, samples.size() - 1);
+  return samples[low] + (position - low) * (samples[high] - samples[low]);
+}
+
+// Appends the nanoseconds of repetitions calls of kernel to samples.
+void Sample(const std::function<void()>& kernel, int repetitions,
+            std::vector<double>* samples) {
+  for (int i = 0; i < repetitions; i++) {
+    auto start = std::chrono::steady_clock::now();
+    kernel();
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    samples->push_back(elapsed.count());
+  }
+}
+
+// Centre percentile (the median by default), 95th percentile and the
+// median absolute deviation from the centre.
+Summary Summarize(std::vector<double> samples, double centre = 0.5) {
+  Summary summary{Percentile(samples, centre), Percentile(samples, 0.95), 0};
+  for (double& sample : samples) sample = std::fabs(sample - summary.median);
+  summary.mad = Percentile(samples, 0.5);
+  return summary;
+}
+
+Summary Run(const Workload& workload, int repetitions) {
+  std::function<void()> kernel = workload.prepare(workload.size);
+  for (int i = 0; i < kWarmup; i++) kernel();
+  std::vector<double> samples;
+  Sample(kernel, repetitions, &samples);
+  return Summarize(samples);
+}
+
+std::string Key(const std::string& operation, int size) {
+  return operation + " " + std::to_string(size);
+}
+
+// Empty when the file cannot be read.
+std::map<std::string, Summary> Load(const std::string& path) {
+  std::map<std::string, Summary> baseline;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    std::string operation;
+    int size = 0;
+    Summary summary{};
+    if (fields >> operation >> size >> summary.median >> summary.p95 >>
+        summary.mad) {
+      baseline[Key(operation, size)] = summary;
+    }
+  }
+  return baseline;
+}
+
+double Noise(const Summary& current, const Summary& base) {
+  return std::max(base.mad / base.median, current.mad / current.median);
+}
+
+// Times are first scaled by how much faster the reference kernel ran in
+// the baseline. A workload regresses when its scaled median grows by more
+// than the tolerance plus three times the relative noise (MAD / median) of
+// either run and of the reference. The tail is noisier, so p95 gets twice
+// that allowance.
+bool Compare(const Summary& current, const Summary& base,
+             const Summary& current_reference, const Summary& base_reference,
+             double tolerance, double* change) {
+  double scale = base_reference.median / current_reference.median;
+  double noise =
+      Noise(current, base) + Noise(current_reference, base_reference);
+  double allowed = tolerance + 3.0 * noise;
+  *change = scale * current.median / base.median - 1.0;
+  double tail_change = scale * current.p95 / base.p95 - 1.0;
+  return *change <= allowed && tail_change <= 2.0 * allowed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string baseline_path = "tests/perf/baseline.txt";
+  bool record = false;
+  int repetitions = 30;
+  double tolerance = 0.10;
+  for (int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    bool has_value = i + 1 < argc;
+    if (argument == "--record") {
+      record = true;
+    } else if (argument == "--baseline" && has_value) {
+      baseline_path = argv[++i];
+    } else if (argument == "--repetitions" && has_value) {
+      repetitions = std::max(1, std::atoi(argv[++i]));
+    } else if (argument == "--tolerance" && has_value) {
+      tolerance = std::atof(argv[++i]);
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--record] [--baseline FILE] [--repetitions N]"
+                   " [--tolerance X]\n";
+      return 2;
+    }
+  }
+  omp_set_num_threads(1);
+  S21BackendScope builtin("builtin");
+  std::map<std::string, Summary> baseline;
+  std::string reference_key = Key(kReference, kReferenceSize);
+  if (!record) {
+    baseline = Load(baseline_path);
+    if (baseline.empty() || !baseline.count(reference_key)) {
+      std::cerr << "cannot read a baseline with a " << kReference
+                << " timing from " << baseline_path
+                << "; record one with --record\n";
+      return 2;
+    }
+  }
+  std::ostringstream recorded;
+  recorded << std::fixed << std::setprecision(0);
+  recorded << "# operation size median_ns p95_ns mad_ns\n";
+  int failures = 0;
+  std::printf("%-8s %-16s %6s %14s %14s %9s\n", "status", "operation", "size",
+              "median_ns", "baseline_ns", "change");
+  std::function<void()> reference_kernel = Reference(kReferenceSize);
+  for (int i = 0; i < kWarmup; i++) reference_kernel();
+  std::vector<double> reference_samples;
+  std::vector<Workload> workloads = Workloads();
+  std::vector<Summary> results;
+  for (const Workload& workload : workloads) {
+    reference_kernel();  // refill the caches the last workload evicted
+    Sample(reference_kernel, kReferenceSamples, &reference_samples);
+    results.push_back(Run(workload, repetitions));
+  }
+  Summary reference = Summarize(reference_samples, kReferenceCentre);
+  workloads.insert(workloads.begin(), {kReference, kReferenceSize, nullptr});
+  results.insert(results.begin(), reference);
+  std::set<std::string> measured;
+  for (std::size_t w = 0; w < workloads.size(); w++) {
+    const Workload& workload = workloads[w];
+    const Summary& current = results[w];
+    std::string key = Key(workload.operation, workload.size);
+    measured.insert(key);
+    recorded << workload.operation << " " << workload.size << " "
+             << current.median << " " << current.p95 << " " << current.mad
+             << "\n";
+    auto base = baseline.find(key);
+    const char* status = "RECORD";
+    double change = 0, base_median = 0;
+    if (!record && key == reference_key) {
+      base_median = base->second.median;
+      change = current.median / base_median - 1.0;
+      status = "REF";
+    } else if (!record && base == baseline.end()) {
+      status = "NEW";
+    } else if (!record) {
+      base_median = base->second.median;
+      bool passed = Compare(current, base->second, reference,
+                            baseline.at(reference_key), tolerance, &change);
+      status = passed ? "PASS" : "FAIL";
+      failures += !passed;
+    }
+    std::printf("%-8s %-16s %6d %14.0f %14.0f %+8.1f%%\n", status,
+                workload.operation.c_str(), workload.size, current.median,
+                base_median, 100.0 * change);
+  }
+  for (const auto& entry : baseline) {
+    if (measured.count(entry.first)) continue;
+    std::printf("%-8s %-23s %14s %14.0f\n", "MISSING", entry.first.c_str(),
+                "-", entry.second.median);
+    failures++;
+  }
+  if (record) {
+    std::ofstream(baseline_path) << recorded.str();
+    std::printf("baseline written to %s\n", baseline_path.c_str());
+  } else if (failures > 0) {
+    std::printf("%d workload(s) regressed or missing\n", failures);
+  } else {
+    std::printf("no regressions\n");
+  }
+  return failures > 0 ? 1 : 0;
+}
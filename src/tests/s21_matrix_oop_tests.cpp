@@ -1,6 +1,21 @@
 #include <gtest/gtest.h>
 
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include "s21_backend.hpp"
+#include "s21_inverse_updater.hpp"
+#include "s21_maintained_product.hpp"
+#include "s21_memory.hpp"
 #include "s21_matrix_oop.hpp"
+#include "s21_metrics.hpp"
+#include "s21_packed_matrix.hpp"
+#include "s21_tiled_matrix.hpp"
+#include "s21_trace.hpp"
+#include "s21_tuner.hpp"
 
 TEST(S21MatrixTest, DefaultMatrixCreation) {
   // Test that the default matrix creation does not throw an exception
@@ -1820,3 +1835,1488 @@ TEST(S21MatrixTest, OperatorCall_ColIndexOutOfBounds) {
   S21Matrix matrix(3, 3);
   EXPECT_THROW(matrix(1, 3), std::runtime_error);
 }
+
+static S21Matrix FilledMatrix(int rows, int cols, int seed) {
+  S21Matrix matrix(rows, cols);
+  unsigned state = 2654435761u * (seed + 1);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      state = state * 1664525u + 1013904223u;
+      matrix(i, j) = (state >> 8) / 16777216.0 * 4.0 - 2.0;
+    }
+  }
+  return matrix;
+}
+
+TEST(S21MatrixTest, QrDecomposition_Reconstructs) {
+  S21Matrix a = FilledMatrix(70, 45, 1);
+  S21Matrix q, r;
+  a.QrDecomposition(q, r);
+  EXPECT_EQ(q.get_rows(), 70);
+  EXPECT_EQ(q.get_cols(), 45);
+  EXPECT_EQ(r.get_rows(), 45);
+  EXPECT_EQ(r.get_cols(), 45);
+  EXPECT_TRUE(q * r == a);
+}
+
+TEST(S21MatrixTest, QrDecomposition_OrthonormalQ) {
+  S21Matrix a = FilledMatrix(50, 40, 2);
+  S21Matrix q, r;
+  a.QrDecomposition(q, r);
+  S21Matrix identity(40, 40);
+  for (int i = 0; i < 40; i++) identity(i, i) = 1.0;
+  EXPECT_TRUE(q.Transpose() * q == identity);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < i; j++) EXPECT_EQ(r(i, j), 0.0);
+  }
+}
+
+TEST(S21MatrixTest, QrDecomposition_WideMatrix) {
+  S21Matrix a = FilledMatrix(3, 5, 3);
+  S21Matrix q, r;
+  a.QrDecomposition(q, r);
+  EXPECT_EQ(q.get_cols(), 3);
+  EXPECT_EQ(r.get_cols(), 5);
+  EXPECT_TRUE(q * r == a);
+}
+
+TEST(S21MatrixTest, SolveLeastSquares_ExactSystem) {
+  S21Matrix a(4, 2);
+  S21Matrix b(4, 1);
+  for (int i = 0; i < 4; i++) {
+    a(i, 0) = 1.0;
+    a(i, 1) = i;
+    b(i, 0) = 3.0 + 2.0 * i;
+  }
+  S21Matrix x = a.SolveLeastSquares(b);
+  EXPECT_NEAR(x(0, 0), 3.0, 1e-12);
+  EXPECT_NEAR(x(1, 0), 2.0, 1e-12);
+}
+
+TEST(S21MatrixTest, SolveLeastSquares_NormalEquations) {
+  S21Matrix a = FilledMatrix(90, 35, 4);
+  S21Matrix b = FilledMatrix(90, 2, 5);
+  S21Matrix x = a.SolveLeastSquares(b);
+  S21Matrix residual(b);
+  for (int i = 0; i < 90; i++) {
+    for (int j = 0; j < 2; j++) {
+      for (int k = 0; k < 35; k++) residual(i, j) -= a(i, k) * x(k, j);
+    }
+  }
+  for (int c = 0; c < 35; c++) {
+    for (int j = 0; j < 2; j++) {
+      double dot = 0;
+      for (int i = 0; i < 90; i++) dot += a(i, c) * residual(i, j);
+      EXPECT_NEAR(dot, 0.0, 1e-10);
+    }
+  }
+}
+
+TEST(S21MatrixTest, SolveLeastSquares_Errors) {
+  S21Matrix wide(2, 3);
+  S21Matrix b(2, 1);
+  EXPECT_THROW(wide.SolveLeastSquares(b), std::runtime_error);
+  S21Matrix tall(3, 2);
+  EXPECT_THROW(tall.SolveLeastSquares(b), std::runtime_error);
+  S21Matrix b3(3, 1);
+  EXPECT_THROW(tall.SolveLeastSquares(b3), std::runtime_error);
+}
+
+static S21Matrix MaskedMatrix(int size, int lower, int upper, int seed) {
+  S21Matrix matrix = FilledMatrix(size, size, seed);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      if (j < i - lower || j > i + upper) matrix(i, j) = 0;
+    }
+    matrix(i, i) += 4.0;
+  }
+  return matrix;
+}
+
+TEST(S21PackedMatrixTest, StoredElements) {
+  EXPECT_EQ(S21PackedMatrix(10, S21Structure::kSymmetric).get_stored_elements(),
+            55u);
+  EXPECT_EQ(
+      S21PackedMatrix(10, S21Structure::kUpperTriangular).get_stored_elements(),
+      55u);
+  EXPECT_EQ(S21PackedMatrix(10, S21Structure::kDiagonal).get_stored_elements(),
+            10u);
+  EXPECT_EQ(
+      S21PackedMatrix(10, S21Structure::kBanded, 1, 1).get_stored_elements(),
+      30u);
+  EXPECT_THROW(S21PackedMatrix(0, S21Structure::kDiagonal), std::runtime_error);
+  EXPECT_THROW(S21PackedMatrix(3, S21Structure::kBanded, 3, 0),
+               std::runtime_error);
+}
+
+TEST(S21PackedMatrixTest, SymmetricElements) {
+  S21PackedMatrix matrix(3, S21Structure::kSymmetric);
+  matrix.set_element_matrix_(0, 2, 5.0);
+  EXPECT_EQ(matrix.get_element_matrix_(2, 0), 5.0);
+  S21PackedMatrix lower(3, S21Structure::kLowerTriangular);
+  EXPECT_THROW(lower.set_element_matrix_(0, 2, 1.0), std::runtime_error);
+  EXPECT_NO_THROW(lower.set_element_matrix_(0, 2, 0.0));
+  EXPECT_THROW(lower.get_element_matrix_(3, 0), std::runtime_error);
+}
+
+TEST(S21PackedMatrixTest, MulMatrixMatchesDense) {
+  S21Matrix b = FilledMatrix(9, 4, 7);
+  S21Matrix full = FilledMatrix(9, 9, 8);
+  S21Matrix symmetric = full + full.Transpose();
+  S21PackedMatrix packed(symmetric, S21Structure::kSymmetric);
+  EXPECT_TRUE(packed * b == symmetric * b);
+  S21Matrix upper = MaskedMatrix(9, 0, 8, 9);
+  EXPECT_TRUE(S21PackedMatrix(upper, S21Structure::kUpperTriangular) * b ==
+              upper * b);
+  S21Matrix band = MaskedMatrix(9, 2, 1, 10);
+  EXPECT_TRUE(S21PackedMatrix(band, S21Structure::kBanded, 2, 1) * b ==
+              band * b);
+}
+
+TEST(S21PackedMatrixTest, SumAndTranspose) {
+  S21Matrix lower = MaskedMatrix(6, 5, 0, 11);
+  S21Matrix diagonal = MaskedMatrix(6, 0, 0, 12);
+  S21PackedMatrix packed_lower(lower, S21Structure::kLowerTriangular);
+  S21PackedMatrix packed_diagonal(diagonal, S21Structure::kDiagonal);
+  S21PackedMatrix sum = packed_diagonal + packed_lower;
+  EXPECT_EQ(sum.get_structure(), S21Structure::kLowerTriangular);
+  EXPECT_TRUE(sum.ToDense() == lower + diagonal);
+  EXPECT_TRUE((packed_lower - packed_diagonal).ToDense() == lower - diagonal);
+  S21PackedMatrix transposed = packed_lower.Transpose();
+  EXPECT_EQ(transposed.get_structure(), S21Structure::kUpperTriangular);
+  EXPECT_TRUE(transposed.ToDense() == lower.Transpose());
+  S21PackedMatrix band(MaskedMatrix(6, 2, 1, 13), S21Structure::kBanded, 2, 1);
+  EXPECT_EQ(band.Transpose().get_lower_bandwidth(), 1);
+  EXPECT_TRUE(band.Transpose().ToDense() == band.ToDense().Transpose());
+  EXPECT_THROW(packed_lower + packed_lower.Transpose(), std::runtime_error);
+}
+
+TEST(S21PackedMatrixTest, Determinant) {
+  S21Matrix upper = MaskedMatrix(5, 0, 4, 14);
+  EXPECT_NEAR(S21PackedMatrix(upper, S21Structure::kUpperTriangular)
+                  .Determinant(),
+              upper.Determinant(), 1e-9);
+  S21Matrix band = MaskedMatrix(6, 1, 2, 15);
+  EXPECT_NEAR(S21PackedMatrix(band, S21Structure::kBanded, 1, 2).Determinant(),
+              band.Determinant(), 1e-9);
+  S21Matrix full = FilledMatrix(5, 5, 16);
+  S21Matrix symmetric = full + full.Transpose();
+  EXPECT_NEAR(S21PackedMatrix(symmetric, S21Structure::kSymmetric)
+                  .Determinant(),
+              symmetric.Determinant(), 1e-9);
+}
+
+TEST(S21PackedMatrixTest, Solve) {
+  S21Matrix b = FilledMatrix(40, 3, 17);
+  S21Matrix tridiagonal = MaskedMatrix(40, 1, 1, 18);
+  S21PackedMatrix packed(tridiagonal, S21Structure::kBanded, 1, 1);
+  EXPECT_TRUE(tridiagonal * packed.Solve(b) == b);
+  S21Matrix lower = MaskedMatrix(40, 39, 0, 19);
+  S21PackedMatrix packed_lower(lower, S21Structure::kLowerTriangular);
+  EXPECT_TRUE(lower * packed_lower.Solve(b) == b);
+  S21Matrix band = MaskedMatrix(40, 3, 2, 20);
+  S21PackedMatrix packed_band(band, S21Structure::kBanded, 3, 2);
+  EXPECT_TRUE(band * packed_band.Solve(b) == b);
+  S21Matrix full = FilledMatrix(40, 40, 21);
+  S21Matrix symmetric = full + full.Transpose();
+  S21PackedMatrix packed_symmetric(symmetric, S21Structure::kSymmetric);
+  EXPECT_TRUE(symmetric * packed_symmetric.Solve(b) == b);
+}
+
+TEST(S21PackedMatrixTest, SolveTridiagonalZeroPivot) {
+  S21Matrix tridiagonal(3, 3);
+  tridiagonal(0, 1) = 1;
+  tridiagonal(1, 0) = 1;
+  tridiagonal(1, 2) = 1;
+  tridiagonal(2, 1) = 1;
+  tridiagonal(2, 2) = 1;
+  S21Matrix b = FilledMatrix(3, 1, 22);
+  S21PackedMatrix packed(tridiagonal, S21Structure::kBanded, 1, 1);
+  EXPECT_TRUE(tridiagonal * packed.Solve(b) == b);
+  S21PackedMatrix singular(3, S21Structure::kDiagonal);
+  EXPECT_THROW(singular.Solve(b), std::runtime_error);
+  EXPECT_EQ(singular.Determinant(), 0.0);
+}
+
+TEST(S21PackedMatrixTest, ScratchFailureIsNotSingular) {
+  S21Matrix b = FilledMatrix(40, 3, 23);
+  S21PackedMatrix band(MaskedMatrix(40, 3, 2, 24), S21Structure::kBanded, 3,
+                       2);
+  S21Matrix full = FilledMatrix(40, 40, 25);
+  S21PackedMatrix symmetric(full + full.Transpose(),
+                            S21Structure::kSymmetric);
+  S21Memory::SetBudget(S21Memory::Global().live_bytes + 1024);
+  EXPECT_THROW(band.Determinant(), S21MemoryError);
+  EXPECT_THROW(symmetric.Determinant(), S21MemoryError);
+  S21Memory::SetBudget(S21Memory::Global().live_bytes + 1792);
+  EXPECT_THROW(band.Solve(b), S21MemoryError);
+  S21Memory::SetBudget(0);
+  EXPECT_NE(band.Determinant(), 0.0);
+}
+
+TEST(S21MatrixTest, Gemv_MatchesMulMatrix) {
+  S21Matrix a = FilledMatrix(300, 250, 23);
+  S21Matrix column = FilledMatrix(250, 1, 24);
+  std::vector<double> x(250), y(300, 1.0);
+  for (int i = 0; i < 250; i++) x[i] = column(i, 0);
+  a.Gemv(2.0, x, 0.5, y);
+  S21Matrix expected = a * column;
+  for (int i = 0; i < 300; i++) {
+    EXPECT_NEAR(y[i], 2.0 * expected(i, 0) + 0.5, 1e-9);
+  }
+}
+
+TEST(S21MatrixTest, Gemv_Transposed) {
+  S21Matrix a = FilledMatrix(600, 700, 25);
+  std::vector<double> x(600), y(700, 3.0);
+  for (int i = 0; i < 600; i++) x[i] = i % 7 - 3.0;
+  a.Gemv(1.0, x, 0.0, y, true);
+  for (int j = 0; j < 700; j += 37) {
+    double expected = 0;
+    for (int i = 0; i < 600; i++) expected += a(i, j) * x[i];
+    EXPECT_NEAR(y[j], expected, 1e-9);
+  }
+}
+
+TEST(S21MatrixTest, Gemv_WrongSizes) {
+  S21Matrix a(3, 2);
+  std::vector<double> x(3), y(3);
+  EXPECT_THROW(a.Gemv(1.0, x, 0.0, y), std::runtime_error);
+  std::vector<double> y2(2);
+  EXPECT_NO_THROW(a.Gemv(1.0, x, 0.0, y2, true));
+}
+
+TEST(S21MatrixTest, Ger_RankOneUpdate) {
+  S21Matrix a = FilledMatrix(4, 3, 26);
+  S21Matrix original(a);
+  std::vector<double> x = {1, 2, 3, 4}, y = {-1, 0, 2};
+  a.Ger(0.5, x, y);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_DOUBLE_EQ(a(i, j), original(i, j) + 0.5 * x[i] * y[j]);
+    }
+  }
+  EXPECT_THROW(a.Ger(1.0, y, x), std::runtime_error);
+}
+
+TEST(S21MatrixTest, Gemm_FusedAccumulate) {
+  S21Matrix a = FilledMatrix(70, 90, 27);
+  S21Matrix b = FilledMatrix(90, 60, 28);
+  S21Matrix c = FilledMatrix(70, 60, 29);
+  S21Matrix expected = a * b * 0.5 + c * 2.0;
+  c.Gemm(a, b, 0.5, 2.0);
+  EXPECT_TRUE(c == expected);
+}
+
+TEST(S21MatrixTest, Gemm_TransposeFlags) {
+  S21Matrix a = FilledMatrix(40, 30, 30);
+  S21Matrix b = FilledMatrix(50, 40, 31);
+  S21Matrix c(30, 50);
+  c.Gemm(a, b, 1.0, 0.0, true, true);
+  EXPECT_TRUE(c == a.Transpose() * b.Transpose());
+  S21Matrix gram(30, 30);
+  gram.Gemm(a, a, 1.0, 0.0, true, false);
+  EXPECT_TRUE(gram == a.Transpose() * a);
+}
+
+TEST(S21MatrixTest, Gemm_AliasedOperand) {
+  S21Matrix c = FilledMatrix(5, 5, 32);
+  S21Matrix expected = c * c + c;
+  c.Gemm(c, c, 1.0, 1.0);
+  EXPECT_TRUE(c == expected);
+}
+
+TEST(S21MatrixTest, Gemm_WrongDimensions) {
+  S21Matrix a(2, 3), b(3, 4), c(2, 3);
+  EXPECT_THROW(c.Gemm(a, b), std::runtime_error);
+  EXPECT_THROW(c.Gemm(a, b, 1.0, 0.0, true), std::runtime_error);
+}
+
+TEST(S21MatrixTest, MulMatrix_UpdatesShape) {
+  S21Matrix a = FilledMatrix(3, 4, 33);
+  S21Matrix b = FilledMatrix(4, 2, 34);
+  a.MulMatrix(b);
+  EXPECT_EQ(a.get_rows(), 3);
+  EXPECT_EQ(a.get_cols(), 2);
+}
+
+TEST(S21MatrixTest, MulChain_MatchesLeftToRight) {
+  S21Matrix a = FilledMatrix(30, 2, 35);
+  S21Matrix b = FilledMatrix(2, 40, 36);
+  S21Matrix c = FilledMatrix(40, 3, 37);
+  S21Matrix d = FilledMatrix(3, 25, 38);
+  S21Matrix e = FilledMatrix(25, 2, 39);
+  S21Matrix expected = a * b * c * d * e;
+  EXPECT_TRUE(S21Matrix::MulChain({a, b, c, d, e}) == expected);
+}
+
+TEST(S21MatrixTest, MulChain_Order) {
+  S21Matrix a(100, 2), b(2, 100), c(100, 2);
+  EXPECT_EQ(S21Matrix::MulChainOrder({a, b, c}), "(A0 (A1 A2))");
+  S21Matrix d(2, 100), e(100, 2), f(2, 100);
+  EXPECT_EQ(S21Matrix::MulChainOrder({d, e, f}), "((A0 A1) A2)");
+}
+
+TEST(S21MatrixTest, MulChain_ParallelSubproducts) {
+  S21Matrix a = FilledMatrix(400, 400, 40);
+  S21Matrix b = FilledMatrix(400, 4, 41);
+  S21Matrix c = FilledMatrix(4, 400, 42);
+  S21Matrix d = FilledMatrix(400, 400, 43);
+  EXPECT_EQ(S21Matrix::MulChainOrder({a, b, c, d}), "((A0 A1) (A2 A3))");
+  S21Matrix expected = (a * b) * (c * d);
+  EXPECT_TRUE(S21Matrix::MulChain({a, b, c, d}) == expected);
+}
+
+TEST(S21MatrixTest, MulChain_Errors) {
+  S21Matrix a(2, 3), b(2, 3);
+  EXPECT_THROW(S21Matrix::MulChain({a, b}), std::runtime_error);
+  EXPECT_THROW(S21Matrix::MulChain({}), std::runtime_error);
+  EXPECT_TRUE(S21Matrix::MulChain({a}) == a);
+}
+
+TEST(S21MatrixTest, Syrk_MatchesProduct) {
+  S21Matrix a = FilledMatrix(150, 70, 44);
+  EXPECT_TRUE(a.Syrk() == a * a.Transpose());
+  EXPECT_TRUE(a.Syrk(true) == a.Transpose() * a);
+  S21Matrix gram = a.Syrk(true);
+  EXPECT_EQ(gram.get_rows(), 70);
+  EXPECT_EQ(gram(3, 60), gram(60, 3));
+}
+
+TEST(S21PackedMatrixTest, SyrkPacked) {
+  S21Matrix a = FilledMatrix(20, 90, 45);
+  S21PackedMatrix gram = S21PackedMatrix::Syrk(a);
+  EXPECT_EQ(gram.get_structure(), S21Structure::kSymmetric);
+  EXPECT_EQ(gram.get_stored_elements(), 210u);
+  EXPECT_TRUE(gram.ToDense() == a * a.Transpose());
+  EXPECT_TRUE(S21PackedMatrix::Syrk(a, true).ToDense() == a.Transpose() * a);
+}
+
+TEST(S21MatrixTest, Pow_MatchesRepeatedProduct) {
+  S21Matrix a = FilledMatrix(12, 12, 46) * 0.3;
+  S21Matrix expected = a;
+  for (int i = 1; i < 13; i++) expected *= a;
+  EXPECT_TRUE(a.Pow(13) == expected);
+  EXPECT_TRUE(a.Pow(1) == a);
+  S21Matrix identity(12, 12);
+  for (int i = 0; i < 12; i++) identity(i, i) = 1.0;
+  EXPECT_TRUE(a.Pow(0) == identity);
+}
+
+TEST(S21MatrixTest, Pow_Negative) {
+  S21Matrix a = FilledMatrix(6, 6, 47);
+  EXPECT_TRUE(a.Pow(-2) * a.Pow(2) == a.Pow(0));
+  S21Matrix singular(3, 3);
+  singular(0, 1) = 1.0;
+  EXPECT_THROW(singular.Pow(-1), std::runtime_error);
+}
+
+TEST(S21MatrixTest, Pow_DiagonalAndTriangular) {
+  S21Matrix diagonal(3, 3);
+  diagonal(0, 0) = 2.0;
+  diagonal(1, 1) = -1.0;
+  diagonal(2, 2) = 0.5;
+  S21Matrix powered = diagonal.Pow(5);
+  EXPECT_DOUBLE_EQ(powered(0, 0), 32.0);
+  EXPECT_DOUBLE_EQ(powered(1, 1), -1.0);
+  EXPECT_DOUBLE_EQ(powered(2, 2), 1.0 / 32.0);
+  EXPECT_DOUBLE_EQ(powered(0, 1), 0.0);
+  EXPECT_DOUBLE_EQ(diagonal.Pow(-1)(0, 0), 0.5);
+  S21Matrix upper = FilledMatrix(8, 8, 48) * 0.4;
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < i; j++) upper(i, j) = 0;
+  }
+  S21Matrix expected = upper * upper * upper * upper * upper * upper * upper;
+  EXPECT_TRUE(upper.Pow(7) == expected);
+  S21Matrix lower = upper.Transpose();
+  EXPECT_TRUE(lower.Pow(7) == expected.Transpose());
+  EXPECT_THROW(S21Matrix(2, 3).Pow(2), std::runtime_error);
+}
+
+TEST(S21MatrixTest, Expm_Diagonal) {
+  S21Matrix a(2, 2);
+  a(0, 0) = 1.0;
+  a(1, 1) = -2.0;
+  S21Matrix result = a.Expm();
+  EXPECT_NEAR(result(0, 0), std::exp(1.0), 1e-13);
+  EXPECT_NEAR(result(1, 1), std::exp(-2.0), 1e-13);
+  EXPECT_NEAR(result(0, 1), 0.0, 1e-13);
+}
+
+TEST(S21MatrixTest, Expm_Rotation) {
+  S21Matrix a(2, 2);
+  a(0, 1) = -30.0;
+  a(1, 0) = 30.0;
+  S21Matrix result = a.Expm();
+  EXPECT_NEAR(result(0, 0), std::cos(30.0), 1e-10);
+  EXPECT_NEAR(result(0, 1), -std::sin(30.0), 1e-10);
+  EXPECT_NEAR(result(1, 0), std::sin(30.0), 1e-10);
+}
+
+TEST(S21MatrixTest, Expm_AllPadeDegrees) {
+  S21Matrix base = FilledMatrix(6, 6, 49);
+  for (double scale : {0.001, 0.04, 0.15, 0.3, 2.0}) {
+    S21Matrix a = base * scale;
+    S21Matrix series(6, 6), term(6, 6);
+    for (int i = 0; i < 6; i++) term(i, i) = 1.0;
+    for (int k = 1; k < 80; k++) {
+      series += term;
+      term = term * a * (1.0 / k);
+    }
+    S21Matrix result(6, 6);
+    S21Workspace workspace;
+    a.Expm(result, workspace);
+    EXPECT_TRUE(result == series) << scale;
+  }
+}
+
+TEST(S21MatrixTest, Polynomial_MatchesHorner) {
+  S21Matrix a = FilledMatrix(7, 7, 50) * 0.2;
+  std::vector<double> coefficients;
+  for (int i = 0; i < 17; i++) coefficients.push_back(1.0 / (i + 1) - 0.3);
+  S21Workspace workspace;
+  S21Matrix result;
+  for (std::size_t degree = 0; degree < coefficients.size(); degree++) {
+    std::vector<double> prefix(coefficients.begin(),
+                               coefficients.begin() + degree + 1);
+    S21Matrix expected(7, 7);
+    for (int i = static_cast<int>(degree); i >= 0; i--) {
+      expected = expected * a;
+      for (int j = 0; j < 7; j++) expected(j, j) += prefix[i];
+    }
+    a.Polynomial(prefix, result, workspace);
+    EXPECT_TRUE(result == expected) << degree;
+  }
+  EXPECT_TRUE(a.Polynomial({}) == S21Matrix(7, 7));
+  EXPECT_THROW(S21Matrix(2, 3).Polynomial({1.0}), std::runtime_error);
+}
+
+TEST(S21MatrixTest, Functions_ReportScratchFailures) {
+  S21Matrix a = FilledMatrix(16, 16, 51) * 0.3;
+  S21Workspace workspace;
+  S21Matrix result;
+  a.Expm(result, workspace);
+  a.Polynomial({1.0, 0.5, 0.25, 0.125, 0.0625}, result, workspace);
+  S21Memory::SetBudget(S21Memory::Global().live_bytes + 256);
+  EXPECT_THROW(a.Expm(result, workspace), S21MemoryError);
+  EXPECT_THROW(a.Polynomial({1.0, 0.5, 0.25, 0.125, 0.0625}, result,
+                            workspace),
+               S21MemoryError);
+  S21Memory::SetBudget(0);
+}
+
+static S21Matrix IdentityMatrix(int size) {
+  S21Matrix identity(size, size);
+  for (int i = 0; i < size; i++) identity(i, i) = 1.0;
+  return identity;
+}
+
+TEST(S21InverseUpdaterTest, RankOneUpdate) {
+  S21Matrix a = FilledMatrix(6, 6, 51);
+  S21InverseUpdater updater(a);
+  EXPECT_NEAR(updater.get_determinant(), a.Determinant(), 1e-9);
+  std::vector<double> u = {1, 0, 2, -1, 0.5, 3}, v = {0, 1, -1, 2, 0, 1};
+  updater.RankOneUpdate(u, v);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) a(i, j) += u[i] * v[j];
+  }
+  EXPECT_TRUE(updater.get_matrix() == a);
+  EXPECT_TRUE(a * updater.get_inverse() == IdentityMatrix(6));
+  EXPECT_NEAR(updater.get_determinant(), a.Determinant(), 1e-8);
+}
+
+TEST(S21InverseUpdaterTest, RankUpdate) {
+  S21Matrix a = FilledMatrix(30, 30, 52);
+  S21Matrix u = FilledMatrix(30, 3, 53);
+  S21Matrix v = FilledMatrix(30, 3, 54);
+  S21InverseUpdater start(a);
+  S21InverseUpdater updater(a, start.get_inverse(), start.get_determinant());
+  updater.RankUpdate(u, v);
+  S21Matrix updated = a + u * v.Transpose();
+  EXPECT_TRUE(updated * updater.get_inverse() == IdentityMatrix(30));
+  S21InverseUpdater reference(updated);
+  EXPECT_NEAR(updater.get_determinant() / reference.get_determinant(), 1.0,
+              1e-9);
+  EXPECT_EQ(updater.get_refactorizations(), 0);
+}
+
+TEST(S21InverseUpdaterTest, ReplaceRowAndColumn) {
+  S21Matrix a = FilledMatrix(5, 5, 55);
+  S21InverseUpdater updater(a);
+  std::vector<double> row = {1, 2, 3, 4, 5}, column = {-1, 0, 1, 0, 2};
+  updater.ReplaceRow(2, row);
+  updater.ReplaceColumn(4, column);
+  for (int j = 0; j < 5; j++) a(2, j) = row[j];
+  for (int i = 0; i < 5; i++) a(i, 4) = column[i];
+  EXPECT_TRUE(updater.get_matrix() == a);
+  EXPECT_TRUE(a * updater.get_inverse() == IdentityMatrix(5));
+  EXPECT_NEAR(updater.get_determinant(), a.Determinant(), 1e-8);
+  EXPECT_THROW(updater.ReplaceRow(5, row), std::runtime_error);
+}
+
+TEST(S21InverseUpdaterTest, SingularUpdateAndDrift) {
+  S21Matrix a = IdentityMatrix(3);
+  S21InverseUpdater updater(a);
+  EXPECT_THROW(updater.ReplaceRow(0, {0, 1, 0}), std::runtime_error);
+  S21Matrix wrong_inverse = IdentityMatrix(3) * 1.5;
+  S21InverseUpdater drifting(a, wrong_inverse, 1.0, 1e-10);
+  drifting.RankOneUpdate({0, 0, 1}, {0, 0, 1});
+  EXPECT_EQ(drifting.get_refactorizations(), 1);
+  EXPECT_TRUE(drifting.get_matrix() * drifting.get_inverse() ==
+              IdentityMatrix(3));
+  EXPECT_NEAR(drifting.get_determinant(), 2.0, 1e-12);
+}
+
+TEST(S21MaintainedProductTest, SparseUpdates) {
+  S21Matrix a = FilledMatrix(40, 30, 56);
+  S21Matrix b = FilledMatrix(30, 50, 57);
+  S21MaintainedProduct product(a, b);
+  product.SetA(3, 7, 2.5);
+  product.SetRowA(11, std::vector<double>(30, 0.25));
+  product.SetB(4, 9, -1.0);
+  product.SetB(4, 9, 3.0);
+  product.SetB(20, 0, 1.5);
+  product.SetColumnB(17, std::vector<double>(30, -0.5));
+  product.SetB(2, 17, 8.0);
+  EXPECT_TRUE(product.Product() == product.get_a() * product.get_b());
+  EXPECT_EQ(product.get_full_recomputations(), 0);
+  product.SetA(0, 0, 1.0);
+  EXPECT_TRUE(product.Product() == product.get_a() * product.get_b());
+}
+
+TEST(S21MaintainedProductTest, DenseUpdatesFallBack) {
+  S21Matrix a = FilledMatrix(4, 4, 58);
+  S21Matrix b = FilledMatrix(4, 4, 59);
+  S21MaintainedProduct product(a, b);
+  for (int i = 0; i < 4; i++) product.SetRowA(i, {1, 2, 3, 4});
+  EXPECT_TRUE(product.Product() == product.get_a() * product.get_b());
+  EXPECT_EQ(product.get_full_recomputations(), 1);
+  EXPECT_THROW(product.SetA(4, 0, 1.0), std::runtime_error);
+  EXPECT_THROW(product.SetColumnB(0, {1, 2}), std::runtime_error);
+}
+
+TEST(S21MatrixTest, RandomizedSvd_ExactLowRank) {
+  S21Matrix left = FilledMatrix(120, 4, 60);
+  S21Matrix right = FilledMatrix(4, 90, 61);
+  S21Matrix a = left * right;
+  S21Matrix u, vt;
+  std::vector<double> s;
+  a.RandomizedSvd(4, 6, 1, u, s, vt);
+  ASSERT_EQ(s.size(), 4u);
+  EXPECT_EQ(u.get_rows(), 120);
+  EXPECT_EQ(vt.get_cols(), 90);
+  for (int i = 1; i < 4; i++) EXPECT_GE(s[i - 1], s[i]);
+  S21Matrix scaled(u);
+  for (int i = 0; i < 120; i++) {
+    for (int k = 0; k < 4; k++) scaled(i, k) *= s[k];
+  }
+  EXPECT_TRUE(scaled * vt == a);
+  EXPECT_TRUE(u.Transpose() * u == IdentityMatrix(4));
+  EXPECT_TRUE(vt * vt.Transpose() == IdentityMatrix(4));
+}
+
+TEST(S21MatrixTest, RandomizedSvd_SingularValues) {
+  S21Matrix a(50, 40);
+  for (int i = 0; i < 40; i++) a(i, i) = i < 3 ? 100.0 / (i + 1) : 1e-3;
+  S21Matrix u, vt;
+  std::vector<double> s;
+  a.RandomizedSvd(3, 10, 2, u, s, vt, 7);
+  EXPECT_NEAR(s[0], 100.0, 1e-9);
+  EXPECT_NEAR(s[1], 50.0, 1e-9);
+  EXPECT_NEAR(s[2], 100.0 / 3, 1e-9);
+  EXPECT_THROW(a.RandomizedSvd(0, 5, 1, u, s, vt), std::runtime_error);
+  EXPECT_THROW(a.RandomizedSvd(41, 5, 1, u, s, vt), std::runtime_error);
+}
+
+static S21Matrix SymmetricMatrix(int size, int seed) {
+  S21Matrix a = FilledMatrix(size, size, seed);
+  return a + a.Transpose();
+}
+
+TEST(S21MatrixTest, SymmetricEigen_Decomposes) {
+  S21Matrix a = SymmetricMatrix(75, 62);
+  std::vector<double> values;
+  S21Matrix vectors;
+  a.SymmetricEigen(values, vectors);
+  ASSERT_EQ(values.size(), 75u);
+  for (int i = 1; i < 75; i++) EXPECT_LE(values[i - 1], values[i]);
+  S21Matrix lambda(75, 75);
+  for (int i = 0; i < 75; i++) lambda(i, i) = values[i];
+  EXPECT_TRUE(vectors.Transpose() * vectors == IdentityMatrix(75));
+  EXPECT_TRUE(vectors * lambda * vectors.Transpose() == a);
+}
+
+TEST(S21MatrixTest, SymmetricEigen_ValuesOnlyMatchTrace) {
+  S21Matrix a = SymmetricMatrix(40, 63);
+  std::vector<double> values = a.SymmetricEigenvalues();
+  double trace = 0, sum = 0, squares = 0, frobenius = 0;
+  for (int i = 0; i < 40; i++) {
+    trace += a(i, i);
+    sum += values[i];
+    squares += values[i] * values[i];
+    for (int j = 0; j < 40; j++) frobenius += a(i, j) * a(i, j);
+  }
+  EXPECT_NEAR(sum, trace, 1e-9);
+  EXPECT_NEAR(squares, frobenius, 1e-8);
+}
+
+TEST(S21MatrixTest, SymmetricEigen_IndexRange) {
+  S21Matrix a = SymmetricMatrix(60, 64);
+  std::vector<double> all = a.SymmetricEigenvalues();
+  std::vector<double> values;
+  S21Matrix vectors;
+  a.SymmetricEigen(values, vectors, 55, 59);
+  ASSERT_EQ(values.size(), 5u);
+  EXPECT_EQ(vectors.get_rows(), 60);
+  EXPECT_EQ(vectors.get_cols(), 5);
+  for (int k = 0; k < 5; k++) EXPECT_NEAR(values[k], all[55 + k], 1e-10);
+  S21Matrix lambda(5, 5);
+  for (int k = 0; k < 5; k++) lambda(k, k) = values[k];
+  EXPECT_TRUE(a * vectors == vectors * lambda);
+  EXPECT_TRUE(vectors.Transpose() * vectors == IdentityMatrix(5));
+  std::vector<double> lowest = a.SymmetricEigenvalues(0, 2);
+  for (int k = 0; k < 3; k++) EXPECT_NEAR(lowest[k], all[k], 1e-10);
+}
+
+TEST(S21MatrixTest, SymmetricEigen_RepeatedEigenvalues) {
+  S21Matrix a = IdentityMatrix(6) * 2.0;
+  a(5, 5) = 7.0;
+  std::vector<double> values;
+  S21Matrix vectors;
+  a.SymmetricEigen(values, vectors, 1, 5);
+  for (int k = 0; k < 4; k++) EXPECT_NEAR(values[k], 2.0, 1e-12);
+  EXPECT_NEAR(values[4], 7.0, 1e-12);
+  EXPECT_TRUE(vectors.Transpose() * vectors == IdentityMatrix(5));
+}
+
+TEST(S21MatrixTest, SymmetricEigen_Errors) {
+  S21Matrix a = FilledMatrix(4, 4, 65);
+  EXPECT_THROW(a.SymmetricEigenvalues(), std::runtime_error);
+  S21Matrix b = SymmetricMatrix(4, 66);
+  EXPECT_THROW(b.SymmetricEigenvalues(2, 4), std::runtime_error);
+  EXPECT_THROW(b.SymmetricEigenvalues(3, 1), std::runtime_error);
+  EXPECT_THROW(FilledMatrix(3, 4, 67).SymmetricEigenvalues(),
+               std::runtime_error);
+}
+
+TEST(S21MatrixTest, Cholesky_Reconstructs) {
+  S21Matrix b = FilledMatrix(50, 50, 68);
+  S21Matrix a = b * b.Transpose() + IdentityMatrix(50);
+  S21Matrix l = a.Cholesky();
+  for (int i = 0; i < 50; i++) {
+    for (int j = i + 1; j < 50; j++) EXPECT_EQ(l(i, j), 0.0);
+  }
+  EXPECT_TRUE(l * l.Transpose() == a);
+  S21Matrix indefinite = IdentityMatrix(3);
+  indefinite(2, 2) = -1.0;
+  EXPECT_THROW(indefinite.Cholesky(), std::runtime_error);
+}
+
+TEST(S21BackendTest, BuiltinIsAvailable) {
+  std::vector<std::string> names = S21Backend::Available();
+  ASSERT_FALSE(names.empty());
+  EXPECT_EQ(names.front(), "builtin");
+  EXPECT_THROW(S21Backend::Select("missing"), std::runtime_error);
+  EXPECT_THROW(S21BackendScope scope("missing"), std::runtime_error);
+}
+
+TEST(S21BackendTest, ScopeOverridesCurrentThread) {
+  std::string process = S21Backend::Current();
+  {
+    S21BackendScope scope("builtin");
+    EXPECT_EQ(S21Backend::Current(), "builtin");
+  }
+  EXPECT_EQ(S21Backend::Current(), process);
+}
+
+TEST(S21BackendTest, BackendsAgree) {
+  S21Matrix a = FilledMatrix(90, 70, 69);
+  S21Matrix b = FilledMatrix(70, 80, 70);
+  S21Matrix spd = a.Syrk(true) + IdentityMatrix(70);
+  S21Matrix square = FilledMatrix(40, 40, 71);
+  for (const std::string& name : S21Backend::Available()) {
+    EXPECT_TRUE(S21Backend::SelfCheck(name));
+    S21BackendScope scope(name);
+    S21Matrix q, r;
+    a.QrDecomposition(q, r);
+    EXPECT_TRUE(q * r == a);
+    EXPECT_TRUE(a * b == FilledMatrix(90, 70, 69) * b);
+    S21Matrix l = spd.Cholesky();
+    EXPECT_TRUE(l * l.Transpose() == spd);
+    EXPECT_TRUE(square.Pow(-1) * square == IdentityMatrix(40));
+    S21Matrix sum = a;
+    sum += a;
+    sum -= a * 3.0;
+    EXPECT_TRUE(sum == a * -1.0);
+    EXPECT_TRUE(a.Transpose().Transpose() == a);
+  }
+}
+
+TEST(S21BackendTest, SelectProcessWide) {
+  std::string process = S21Backend::Current();
+  S21Backend::Select("builtin");
+  EXPECT_EQ(S21Backend::Current(), "builtin");
+  S21Backend::Select(process);
+  EXPECT_EQ(S21Backend::Current(), process);
+}
+
+TEST(S21TuningTest, ProfileRoundTrip) {
+  std::string path = testing::TempDir() + "s21_tuning_round_trip.profile";
+  s21_tuning_t tuning;
+  s21_tuning_defaults(&tuning);
+  tuning.gemm_mc = 48;
+  tuning.transpose_block = 12;
+  tuning.elementwise_threshold = LONG_MAX;
+  S21Tuner::Save(tuning, path);
+  s21_tuning_t loaded;
+  s21_tuning_defaults(&loaded);
+  ASSERT_EQ(s21_tuning_load(path.c_str(), &loaded), OK);
+  EXPECT_EQ(loaded.gemm_mc, 48);
+  EXPECT_EQ(loaded.transpose_block, 12);
+  EXPECT_EQ(loaded.gemm_kc, S21_GEMM_KC);
+  EXPECT_EQ(loaded.elementwise_threshold, LONG_MAX);
+  std::remove(path.c_str());
+}
+
+TEST(S21TuningTest, RejectsForeignOrBrokenProfiles) {
+  std::string path = testing::TempDir() + "s21_tuning_foreign.profile";
+  s21_tuning_t tuning;
+  s21_tuning_defaults(&tuning);
+  FILE* file = std::fopen(path.c_str(), "w");
+  std::fputs("cpu Some Other Processor\ngemm_mc 8\n", file);
+  std::fclose(file);
+  EXPECT_EQ(s21_tuning_load(path.c_str(), &tuning), CALC_ERROR);
+  EXPECT_EQ(tuning.gemm_mc, S21_GEMM_MC);
+  char model[256];
+  s21_cpu_model(model, sizeof(model));
+  file = std::fopen(path.c_str(), "w");
+  std::fprintf(file, "cpu %s\ngemm_mc 8\nqr_block -4\n", model);
+  std::fclose(file);
+  EXPECT_EQ(s21_tuning_load(path.c_str(), &tuning), CALC_ERROR);
+  EXPECT_EQ(tuning.gemm_mc, S21_GEMM_MC);
+  std::remove(path.c_str());
+  EXPECT_EQ(s21_tuning_load(path.c_str(), &tuning), INCORRECT_MATRIX);
+}
+
+TEST(S21TuningTest, KernelsAgreeUnderAnyTuning) {
+  S21Matrix a = FilledMatrix(53, 41, 72), b = FilledMatrix(41, 37, 73);
+  S21BackendScope builtin("builtin");
+  S21Matrix product = a * b, transpose = a.Transpose(), q, r;
+  std::vector<double> x(53, 1.0), y(41), y_tuned(41);
+  a.Gemv(1.0, x, 0.0, y, true);
+  s21_tuning_t saved = *s21_tuning_current();
+  s21_tuning_t tuned = {7, 5, 9, 3, 3, 5, 0, 0};
+  ASSERT_EQ(s21_tuning_publish(&tuned), OK);
+  EXPECT_TRUE(a * b == product);
+  EXPECT_TRUE(a.Transpose() == transpose);
+  a.Gemv(1.0, x, 0.0, y_tuned, true);
+  for (int i = 0; i < 41; i++) EXPECT_NEAR(y_tuned[i], y[i], 1e-12);
+  a.QrDecomposition(q, r);
+  EXPECT_TRUE(q * r == a);
+  std::thread worker([&] {
+    for (int i = 0; i < 20; i++) EXPECT_TRUE(a * b == product);
+  });
+  for (int i = 0; i < 20; i++) s21_tuning_publish(i % 2 ? &tuned : &saved);
+  worker.join();
+  s21_tuning_publish(&saved);
+  EXPECT_EQ(s21_tuning_current()->gemm_mc, saved.gemm_mc);
+}
+
+TEST(S21MetricsTest, DisabledRecordsNothing) {
+  S21Metrics::Enable(false);
+  S21Metrics::Reset();
+  S21Matrix a = FilledMatrix(8, 8, 74);
+  a.MulMatrix(a);
+  EXPECT_TRUE(S21Metrics::Snapshot().empty());
+}
+
+TEST(S21MetricsTest, RecordsOutermostOperations) {
+  S21Metrics::Reset();
+  S21Metrics::Enable();
+  S21Matrix a = FilledMatrix(20, 30, 75), b = FilledMatrix(30, 10, 76);
+  S21Matrix c = a * b;
+  c.MulMatrix(IdentityMatrix(10));
+  a.Transpose();
+  S21Metrics::Enable(false);
+  std::vector<S21OpStats> snapshot = S21Metrics::Snapshot();
+  ASSERT_EQ(snapshot.size(), 2u);
+  const S21OpStats& mul = snapshot[0];
+  EXPECT_EQ(mul.name, "MulMatrix");
+  EXPECT_EQ(mul.calls, 2u);
+  EXPECT_EQ(mul.flops, 2u * 20 * 30 * 10 + 2u * 20 * 10 * 10);
+  EXPECT_EQ(mul.allocations, 2u);
+  EXPECT_EQ(mul.shapes[5][4], 2u);
+  std::uint64_t latency_calls = 0;
+  for (std::uint64_t bucket : mul.latency) latency_calls += bucket;
+  EXPECT_EQ(latency_calls, 2u);
+  EXPECT_EQ(snapshot[1].name, "Transpose");
+  EXPECT_EQ(snapshot[1].bytes, 16u * 20 * 30);
+  EXPECT_EQ(snapshot[1].shapes[5][5], 1u);
+}
+
+TEST(S21MetricsTest, RecordsVectorAndChainOperations) {
+  S21Matrix a = FilledMatrix(6, 4, 97), b = FilledMatrix(4, 5, 98);
+  S21Matrix c = FilledMatrix(5, 3, 99);
+  std::vector<double> x(4, 1.0), y(6, 0.0);
+  S21Metrics::Reset();
+  S21Metrics::Enable();
+  a.Syrk();
+  a.Gemv(1.0, x, 0.0, y);
+  a.Ger(1.0, y, x);
+  S21Matrix(3, 3).Polynomial({1.0, 2.0, 3.0, 4.0, 5.0});
+  S21Matrix::MulChain({a, b, c});
+  S21Metrics::Enable(false);
+  std::map<std::string, S21OpStats> ops;
+  for (const S21OpStats& stats : S21Metrics::Snapshot())
+    ops[stats.name] = stats;
+  EXPECT_EQ(ops["Syrk"].flops, 6u * 6 * 4);
+  EXPECT_EQ(ops["Gemv"].flops, 2u * 6 * 4);
+  EXPECT_EQ(ops["Ger"].flops, 2u * 6 * 4);
+  EXPECT_EQ(ops["Polynomial"].flops, 2u * 3 * 3 * 3 * 3);
+  EXPECT_EQ(ops["MulChain"].calls, 1u);
+  EXPECT_EQ(ops["MulChain"].flops, 2u * 4 * 5 * 3 + 2u * 6 * 4 * 3);
+  EXPECT_EQ(ops.count("Gemm"), 0u);
+}
+
+TEST(S21MetricsTest, SkipsRejectedCalls) {
+  S21Metrics::Reset();
+  S21Metrics::Enable();
+  S21Matrix a = FilledMatrix(30, 40, 96);
+  EXPECT_THROW(a.Determinant(), std::runtime_error);
+  EXPECT_THROW(a.InverseMatrix(), std::runtime_error);
+  EXPECT_THROW(a.Pow(3), std::runtime_error);
+  EXPECT_THROW(a * a, std::runtime_error);
+  EXPECT_THROW(a.Gemm(a, a), std::runtime_error);
+  S21Metrics::Enable(false);
+  EXPECT_TRUE(S21Metrics::Snapshot().empty());
+}
+
+TEST(S21MetricsTest, Exports) {
+  S21Metrics::Reset();
+  S21Metrics::Enable();
+  S21Matrix a = FilledMatrix(4, 4, 77);
+  a.SumMatrix(a);
+  S21Metrics::Enable(false);
+  std::string text = S21Metrics::Prometheus();
+  EXPECT_NE(text.find("s21_matrix_calls_total{op=\"SumMatrix\"} 1"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_latency_seconds_bucket{op=\"SumMatrix\","
+                      "le=\"+Inf\"} 1"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_shape_total{op=\"SumMatrix\",rows=\"4\","
+                      "cols=\"4\"} 1"),
+            std::string::npos);
+  std::string json = S21Metrics::Json();
+  EXPECT_NE(json.find("\"name\":\"SumMatrix\",\"calls\":1,\"flops\":16"),
+            std::string::npos);
+  std::string path = testing::TempDir() + "s21_metrics.json";
+  S21Metrics::WriteJson(path);
+  std::ifstream file(path);
+  std::string written((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+  EXPECT_EQ(written, json);
+  std::remove(path.c_str());
+  S21Metrics::Reset();
+}
+
+TEST(S21MetricsTest, HardwareCounters) {
+  S21Metrics::Reset();
+  S21Metrics::Enable();
+  bool available = S21Metrics::EnableHardwareCounters();
+  EXPECT_EQ(available, S21HwCounters::Available());
+  S21Matrix a = FilledMatrix(32, 32, 80);
+  a.MulMatrix(a);
+  S21Matrix transposed = a.Transpose();
+  S21Metrics::EnableHardwareCounters(false);
+  S21Metrics::Enable(false);
+  std::vector<S21OpStats> snapshot = S21Metrics::Snapshot();
+  ASSERT_EQ(snapshot.size(), 2u);
+  int cycles = static_cast<int>(S21HwCounter::kCycles);
+  std::string text = S21Metrics::Prometheus();
+  if (available) {
+    EXPECT_EQ(snapshot[0].hardware_calls[cycles], 1u);
+    EXPECT_GT(snapshot[0].hardware[cycles], 0u);
+    EXPECT_NE(text.find("s21_matrix_caller_cycles_total{op=\"MulMatrix\"}"),
+              std::string::npos);
+  } else {
+    for (const S21OpStats& stats : snapshot) {
+      for (std::uint64_t calls : stats.hardware_calls) EXPECT_EQ(calls, 0u);
+    }
+    EXPECT_EQ(text.find("s21_matrix_caller_cycles_total{"),
+              std::string::npos);
+  }
+  S21Metrics::Reset();
+}
+
+static int CountOf(const std::string& text, const std::string& pattern) {
+  int count = 0;
+  for (std::size_t at = text.find(pattern); at != std::string::npos;
+       at = text.find(pattern, at + 1))
+    count++;
+  return count;
+}
+
+TEST(S21TraceTest, DisabledRecordsNothing) {
+  S21Trace::Clear();
+  S21Matrix a = FilledMatrix(8, 8, 78);
+  a.MulMatrix(a);
+  EXPECT_FALSE(S21Trace::Enabled());
+  EXPECT_EQ(CountOf(S21Trace::Json(), "\"ph\":\"B\""), 0);
+}
+
+TEST(S21TraceTest, RecordsOperationsAndPhases) {
+  S21BackendScope scope("builtin");
+  S21Trace::Clear();
+  S21Trace::Enable();
+  S21Matrix a = FilledMatrix(64, 64, 79);
+  S21Matrix product = a * a;
+  S21Matrix spd = a.Transpose() * a + IdentityMatrix(64);
+  S21Matrix lower = spd.Cholesky();
+  S21Trace::Enable(false);
+  std::string json = S21Trace::Json();
+  EXPECT_EQ(CountOf(json, "\"name\":\"MulMatrix\",\"ph\":\"B\""), 2);
+  EXPECT_GT(CountOf(json, "\"name\":\"gemm.tile\",\"ph\":\"B\""), 0);
+  EXPECT_EQ(CountOf(json, "\"name\":\"cholesky.factor\",\"ph\":\"E\""), 1);
+  EXPECT_NE(json.find("\"rows\":64,\"cols\":64,\"algorithm\":\"builtin\""),
+            std::string::npos);
+  EXPECT_EQ(CountOf(json, "\"ph\":\"B\""), CountOf(json, "\"ph\":\"E\""));
+  std::string path = testing::TempDir() + "s21_trace.json";
+  S21Trace::Flush(path);
+  std::ifstream file(path);
+  std::string written((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+  EXPECT_EQ(written, json);
+  std::remove(path.c_str());
+  EXPECT_EQ(CountOf(S21Trace::Json(), "\"ph\":\"B\""), 0);
+}
+
+TEST(S21TraceTest, RecordsFileOperations) {
+  S21Matrix a = FilledMatrix(9, 4, 80);
+  std::string path = testing::TempDir() + "s21_trace_io";
+  S21Trace::Clear();
+  S21Trace::Enable();
+  a.Save(path + ".bin");
+  S21Matrix::Load(path + ".bin");
+  S21Matrix::Map(path + ".bin");
+  a.SaveCsv(path + ".csv");
+  S21Matrix::LoadCsv(path + ".csv");
+  S21Matrix::StreamCsv(path + ".csv", 5, [](const S21Matrix&, int) {});
+  a.SaveMatrixMarket(path + ".mtx");
+  S21Matrix::LoadMatrixMarket(path + ".mtx");
+  S21Trace::Enable(false);
+  std::string json = S21Trace::Json();
+  for (const char* op : {"Save", "Load", "Map", "SaveCsv", "LoadCsv",
+                         "SaveMatrixMarket", "LoadMatrixMarket"}) {
+    std::string name = std::string("\"name\":\"") + op + "\",\"ph\":\"";
+    EXPECT_EQ(CountOf(json, name + "B\""), 1) << op;
+    EXPECT_EQ(CountOf(json, name + "E\""), 1) << op;
+  }
+  EXPECT_EQ(CountOf(json, "\"name\":\"StreamCsv\",\"ph\":\"E\""), 2);
+  // Saves carry the shape on both events, loads once they have parsed it.
+  EXPECT_EQ(CountOf(json, "\"rows\":9,\"cols\":4}"), 3 * 2 + 4);
+  S21Trace::Clear();
+  for (const char* suffix : {".bin", ".csv", ".mtx"})
+    std::remove((path + suffix).c_str());
+}
+
+TEST(S21TraceTest, RingKeepsNewestEvents) {
+  S21Trace::Clear();
+  S21Trace::Enable(true, 3);
+  std::thread worker([] {
+    for (int i = 0; i < 10; i++) S21Trace::Record("probe", 'B', i, 1);
+  });
+  worker.join();
+  S21Trace::Enable(false);
+  std::string json = S21Trace::Json();
+  EXPECT_EQ(CountOf(json, "\"name\":\"probe\""), 4);
+  EXPECT_NE(json.find("\"rows\":9,"), std::string::npos);
+  EXPECT_EQ(json.find("\"rows\":5,"), std::string::npos);
+  S21Trace::Clear();
+}
+
+TEST(S21TraceTest, FinishedThreadsReleaseRings) {
+  S21Trace::Clear();
+  S21Trace::Enable(true, 8);
+  for (int i = 0; i < 20; i++) {
+    std::thread worker([i] { S21Trace::Record("probe", 'B', i, 1); });
+    worker.join();
+  }
+  S21Trace::Enable(false);
+  std::string json = S21Trace::Json();
+  // One ring of 8 events served all workers, each under its own thread.
+  EXPECT_EQ(CountOf(json, "\"name\":\"probe\""), 8);
+  EXPECT_EQ(CountOf(json, "thread_name"), 8);
+  S21Trace::Clear();
+  EXPECT_EQ(CountOf(S21Trace::Json(), "thread_name"), 0);
+}
+
+TEST(S21MemoryTest, AccountsMatrices) {
+  S21MemoryStats before = S21Memory::Global();
+  S21MemoryStats thread_before = S21Memory::Thread();
+  std::int64_t bytes = 100 * 30 * 8 + 100 * 8;
+  {
+    S21Matrix a(100, 30);
+    S21MemoryStats during = S21Memory::Global();
+    EXPECT_EQ(during.live_bytes - before.live_bytes, bytes);
+    EXPECT_EQ(during.allocations - before.allocations, 2);
+    EXPECT_GE(during.peak_bytes, during.live_bytes);
+    EXPECT_EQ(S21Memory::Thread().live_bytes - thread_before.live_bytes, bytes);
+  }
+  EXPECT_EQ(S21Memory::Global().live_bytes, before.live_bytes);
+  EXPECT_EQ(S21Memory::Thread().live_bytes, thread_before.live_bytes);
+}
+
+TEST(S21MemoryTest, BudgetFailsFast) {
+  S21Matrix kept = FilledMatrix(10, 10, 81);
+  std::int64_t failures = S21Memory::Global().failures;
+  S21Memory::SetBudget(S21Memory::Global().live_bytes + (1 << 20));
+  EXPECT_THROW(S21Matrix(1000, 1000), S21MemoryError);
+  EXPECT_NO_THROW(S21Matrix(100, 100));
+  EXPECT_THROW(kept.set_rows(100000), S21MemoryError);
+  EXPECT_EQ(kept.get_rows(), 10);
+  EXPECT_EQ(kept, FilledMatrix(10, 10, 81));
+  S21Matrix big(1, 1);
+  S21Memory::SetBudget(0);
+  S21Matrix large(400, 400);
+  S21Memory::SetBudget(S21Memory::Global().live_bytes + (1 << 20));
+  big(0, 0) = 2.5;
+  EXPECT_THROW(big = large, S21MemoryError);
+  EXPECT_EQ(big.get_rows(), 1);
+  EXPECT_EQ(big(0, 0), 2.5);
+  S21Memory::SetBudget(0);
+  EXPECT_EQ(S21Memory::Global().failures - failures, 3);
+  EXPECT_THROW(S21Matrix(INT_MAX, INT_MAX), S21MemoryError);
+  EXPECT_THROW(S21PackedMatrix(INT_MAX, S21Structure::kSymmetric),
+               S21MemoryError);
+}
+
+TEST(S21MemoryTest, LowerMemoryVariantsNearBudget) {
+  S21Matrix a = FilledMatrix(48, 48, 82);
+  a.MulNumber(0.1);
+  S21Matrix spd = a.Transpose() * a + IdentityMatrix(48);
+  S21Matrix cube = a * a * a, product = a * spd;
+  S21Matrix fifth = cube * a * a;
+  S21Matrix q, r;
+  a.QrDecomposition(q, r);
+  std::vector<double> values = spd.SymmetricEigenvalues();
+  std::int64_t matrix = 48 * 48 * 8 + 48 * 8;
+  S21Memory::SetBudget(S21Memory::Global().live_bytes + 2 * matrix + 4096);
+  EXPECT_EQ(a.Pow(3), cube);
+  EXPECT_EQ(a.Pow(5), fifth);
+  S21Matrix c(48, 48);
+  c.Gemm(a, spd);
+  EXPECT_EQ(c, product);
+  S21Memory::SetBudget(S21Memory::Global().live_bytes + 5 * matrix + 4096);
+  S21Matrix q_low, r_low;
+  a.QrDecomposition(q_low, r_low);
+  EXPECT_EQ(q_low, q);
+  EXPECT_EQ(r_low, r);
+  std::vector<double> values_low = spd.SymmetricEigenvalues();
+  S21Memory::SetBudget(0);
+  ASSERT_EQ(values_low.size(), values.size());
+  for (std::size_t i = 0; i < values.size(); i++)
+    EXPECT_NEAR(values_low[i], values[i], 1e-9);
+}
+
+TEST(S21MemoryTest, PackedScratchFailsWithinBudget) {
+  S21Matrix a = FilledMatrix(64, 64, 97);
+  S21PackedMatrix packed(a.Transpose() * a + IdentityMatrix(64),
+                         S21Structure::kSymmetric);
+  S21Matrix b = FilledMatrix(64, 2, 98);
+  S21Matrix x = packed.Solve(b);
+  S21Memory::SetBudget(S21Memory::Global().live_bytes + 4096);
+  EXPECT_THROW(packed.Solve(b), S21MemoryError);
+  S21Memory::SetBudget(0);
+  EXPECT_EQ(packed.Solve(b), x);
+}
+
+TEST(S21MatrixFileTest, SaveAndLoad) {
+  S21Matrix a = FilledMatrix(37, 21, 83);
+  std::string path = testing::TempDir() + "s21_matrix.bin";
+  a.Save(path);
+  EXPECT_EQ(S21Matrix::Load(path), a);
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(64 + 8 * 100);
+    file.put('\x7f');
+  }
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21Matrix::Map(path, S21MapMode::kReadOnly, true),
+               std::runtime_error);
+  EXPECT_NO_THROW(S21Matrix::Map(path));
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "not a matrix file, not a matrix file, not a matrix file, ...";
+  }
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21Matrix::Map(path), std::runtime_error);
+  EXPECT_THROW(S21Matrix::Load(path + ".missing"), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixFileTest, MapReadOnlyDetachesOnWrite) {
+  S21Matrix a = FilledMatrix(16, 24, 84);
+  std::string path = testing::TempDir() + "s21_matrix_ro.bin";
+  a.Save(path);
+  S21Matrix mapped = S21Matrix::Map(path, S21MapMode::kReadOnly, true);
+  EXPECT_EQ(mapped, a);
+  EXPECT_EQ(mapped * a.Transpose(), a * a.Transpose());
+  S21Matrix copy(mapped);
+  mapped(3, 4) = 100.0;
+  mapped.MulNumber(2.0);
+  EXPECT_DOUBLE_EQ(mapped(3, 4), 200.0);
+  EXPECT_EQ(copy, a);
+  EXPECT_EQ(S21Matrix::Load(path), a);
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixFileTest, MapCopyOnWriteKeepsFile) {
+  S21Matrix a = FilledMatrix(10, 10, 85);
+  std::string path = testing::TempDir() + "s21_matrix_cow.bin";
+  a.Save(path);
+  S21Matrix mapped = S21Matrix::Map(path, S21MapMode::kCopyOnWrite);
+  mapped.SumMatrix(a);
+  EXPECT_EQ(mapped, a * 2.0);
+  S21Matrix moved(std::move(mapped));
+  EXPECT_EQ(moved, a * 2.0);
+  EXPECT_EQ(S21Matrix::Map(path), a);
+  std::remove(path.c_str());
+}
+
+TEST(S21TiledMatrixTest, MulTransposeSum) {
+  S21Matrix a = FilledMatrix(37, 29, 86), b = FilledMatrix(29, 19, 87);
+  std::string dir = testing::TempDir();
+  S21TiledMatrix ta = S21TiledMatrix::FromMatrix(a, dir + "s21_ta.tiles", 8, 4);
+  S21TiledMatrix tb = S21TiledMatrix::FromMatrix(b, dir + "s21_tb.tiles", 8, 4);
+  EXPECT_EQ(ta.ToMatrix(), a);
+  S21TiledMatrix product = ta.MulMatrix(tb, dir + "s21_tab.tiles");
+  EXPECT_EQ(product.get_rows(), 37);
+  EXPECT_EQ(product.get_cols(), 19);
+  EXPECT_EQ(product.ToMatrix(), a * b);
+  S21TiledMatrix transposed = ta.Transpose(dir + "s21_tat.tiles");
+  EXPECT_EQ(transposed.ToMatrix(), a.Transpose());
+  S21TiledMatrix sum = ta.SumMatrix(ta, dir + "s21_taa.tiles");
+  EXPECT_EQ(sum.ToMatrix(), a * 2.0);
+  EXPECT_THROW(ta.MulMatrix(ta, dir + "s21_bad.tiles"), std::runtime_error);
+  EXPECT_THROW(ta.SumMatrix(tb, dir + "s21_bad.tiles"), std::runtime_error);
+  S21TileStats stats = ta.Stats();
+  EXPECT_GT(stats.reads, 0u);
+  EXPECT_GT(stats.writes, 0u);
+  for (const char* name : {"s21_ta", "s21_tb", "s21_tab", "s21_tat", "s21_taa",
+                           "s21_bad"})
+    std::remove((dir + name + ".tiles").c_str());
+}
+
+TEST(S21TiledMatrixTest, ReopenKeepsElements) {
+  std::string path = testing::TempDir() + "s21_reopen.tiles";
+  {
+    S21TiledMatrix matrix(path, 20, 30, 6, 4);
+    for (int i = 0; i < 20; i++) matrix.Set(i, (i * 7) % 30, i + 0.5);
+    EXPECT_DOUBLE_EQ(matrix.Get(3, 21), 3.5);
+    EXPECT_THROW(matrix.Get(20, 0), std::runtime_error);
+  }
+  S21TiledMatrix matrix = S21TiledMatrix::Open(path);
+  EXPECT_EQ(matrix.get_rows(), 20);
+  EXPECT_EQ(matrix.get_cols(), 30);
+  EXPECT_EQ(matrix.get_tile(), 6);
+  for (int i = 0; i < 20; i++)
+    EXPECT_DOUBLE_EQ(matrix.Get(i, (i * 7) % 30), i + 0.5);
+  EXPECT_DOUBLE_EQ(matrix.Get(0, 1), 0.0);
+  std::remove(path.c_str());
+  EXPECT_THROW(S21TiledMatrix::Open(path), std::runtime_error);
+}
+
+TEST(S21TiledMatrixTest, FailedReadIsNotCached) {
+  S21Matrix a = FilledMatrix(20, 20, 95);
+  std::string path = testing::TempDir() + "s21_short.tiles";
+  S21TiledMatrix::FromMatrix(a, path, 4, 4);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+  S21TiledMatrix matrix = S21TiledMatrix::Open(path);
+  EXPECT_DOUBLE_EQ(matrix.Get(0, 0), a(0, 0));
+  EXPECT_THROW(matrix.Get(19, 19), std::runtime_error);
+  EXPECT_THROW(matrix.Get(19, 19), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(S21TiledMatrixTest, RejectsOversizedTiles) {
+  std::string path = testing::TempDir() + "s21_big.tiles";
+  EXPECT_THROW(S21TiledMatrix(path, 10, 10, S21TiledMatrix::kMaxTile + 1),
+               std::runtime_error);
+  S21TiledMatrix::FromMatrix(FilledMatrix(4, 4, 96), path, 2);
+  std::uint32_t tile = S21TiledMatrix::kMaxTile + 1;
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekp(12);
+  file.write(reinterpret_cast<const char*>(&tile), sizeof(tile));
+  file.close();
+  EXPECT_THROW(S21TiledMatrix::Open(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixTextTest, CsvRoundTrip) {
+  S21Matrix a = FilledMatrix(300, 310, 88);
+  a(0, 0) = -1.7976931348623157e+308;
+  a(1, 1) = 5e-324;
+  a(2, 2) = 0.1;
+  std::string path = testing::TempDir() + "s21_matrix.csv";
+  a.SaveCsv(path);
+  S21Matrix loaded = S21Matrix::LoadCsv(path);
+  ASSERT_EQ(loaded.get_rows(), 300);
+  ASSERT_EQ(loaded.get_cols(), 310);
+  for (int i = 0; i < 300; i++)
+    for (int j = 0; j < 310; j++) ASSERT_EQ(loaded(i, j), a(i, j));
+  a.SaveCsv(path, ';');
+  EXPECT_EQ(S21Matrix::LoadCsv(path, ';'), a);
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixTextTest, CsvParsing) {
+  std::string path = testing::TempDir() + "s21_parse.csv";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << " 1, +2.5 ,-3e2\r\n\n4,5,6\r\n  \n7,8,9";
+  }
+  S21Matrix loaded = S21Matrix::LoadCsv(path);
+  ASSERT_EQ(loaded.get_rows(), 3);
+  EXPECT_DOUBLE_EQ(loaded(0, 1), 2.5);
+  EXPECT_DOUBLE_EQ(loaded(0, 2), -300.0);
+  EXPECT_DOUBLE_EQ(loaded(2, 2), 9.0);
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "1  2\t3\n4 5 6 \n";
+  }
+  loaded = S21Matrix::LoadCsv(path, ' ');
+  EXPECT_DOUBLE_EQ(loaded(0, 2), 3.0);
+  EXPECT_DOUBLE_EQ(loaded(1, 2), 6.0);
+  for (const char* bad : {"1,2\n3\n", "1,2\n3,x\n", "1,,2\n", "", "\n\n"}) {
+    std::ofstream(path, std::ios::binary) << bad;
+    EXPECT_THROW(S21Matrix::LoadCsv(path), std::runtime_error) << bad;
+  }
+  std::remove(path.c_str());
+  EXPECT_THROW(S21Matrix::LoadCsv(path), std::runtime_error);
+}
+
+TEST(S21MatrixTextTest, StreamCsvInBlocks) {
+  S21Matrix a = FilledMatrix(30, 4, 89);
+  std::string path = testing::TempDir() + "s21_stream.csv";
+  a.SaveCsv(path);
+  S21Matrix assembled(30, 4);
+  std::vector<int> firsts;
+  S21Matrix::StreamCsv(path, 7, [&](const S21Matrix& block, int first_row) {
+    firsts.push_back(first_row);
+    EXPECT_EQ(block.get_rows(), first_row < 28 ? 7 : 2);
+    for (int i = 0; i < block.get_rows(); i++)
+      for (int j = 0; j < 4; j++)
+        assembled(first_row + i, j) = block.get_element_matrix_(i, j);
+  });
+  EXPECT_EQ(firsts, std::vector<int>({0, 7, 14, 21, 28}));
+  EXPECT_EQ(assembled, a);
+  EXPECT_THROW(S21Matrix::StreamCsv(path, 0, [](const S21Matrix&, int) {}),
+               std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixTextTest, MatrixMarket) {
+  S21Matrix a = FilledMatrix(40, 23, 90);
+  std::string path = testing::TempDir() + "s21_matrix.mtx";
+  a.SaveMatrixMarket(path);
+  S21Matrix loaded = S21Matrix::LoadMatrixMarket(path);
+  EXPECT_EQ(loaded, a);
+  EXPECT_EQ(loaded(39, 22), a(39, 22));
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "%%MatrixMarket matrix coordinate real symmetric\n"
+            "% a comment\n3 3 3\n1 1 2.0\n3 1 -1.5\n2 2 4\n";
+  }
+  loaded = S21Matrix::LoadMatrixMarket(path);
+  EXPECT_DOUBLE_EQ(loaded(0, 0), 2.0);
+  EXPECT_DOUBLE_EQ(loaded(0, 2), -1.5);
+  EXPECT_DOUBLE_EQ(loaded(2, 0), -1.5);
+  EXPECT_DOUBLE_EQ(loaded(1, 1), 4.0);
+  EXPECT_DOUBLE_EQ(loaded(1, 2), 0.0);
+  for (const char* bad :
+       {"%%MatrixMarket matrix coordinate real general\n2 2 1\n3 1 1.0\n",
+        "%%MatrixMarket matrix coordinate real general\n2 2 2\n1 1 1.0\n",
+        "%%MatrixMarket matrix array complex general\n1 1\n1 0\n",
+        "%%MatrixMarket matrix array real general\n2 1\n1.5\n",
+        "not a matrix\n"}) {
+    std::ofstream(path, std::ios::binary) << bad;
+    EXPECT_THROW(S21Matrix::LoadMatrixMarket(path), std::runtime_error)
+        << bad;
+  }
+  std::remove(path.c_str());
+}
+
+TEST(S21MatrixWrapTest, WrapsBufferWithoutCopy) {
+  // 6 x 5 matrix in a buffer with rows 8 elements apart.
+  std::vector<double> buffer(6 * 8, -1.0);
+  S21Matrix expected = FilledMatrix(6, 5, 91);
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 5; j++) buffer[i * 8 + j] = expected(i, j);
+  S21Matrix wrapped(buffer.data(), 6, 5, 8);
+  EXPECT_EQ(wrapped, expected);
+  wrapped(2, 3) = 7.0;
+  EXPECT_DOUBLE_EQ(buffer[2 * 8 + 3], 7.0);
+  expected(2, 3) = 7.0;
+  wrapped.MulNumber(2.0);
+  EXPECT_DOUBLE_EQ(buffer[2 * 8 + 3], 14.0);
+  EXPECT_DOUBLE_EQ(buffer[2 * 8 + 5], -1.0);
+  expected.MulNumber(2.0);
+  EXPECT_EQ(wrapped * wrapped.Transpose(), expected * expected.Transpose());
+  EXPECT_EQ(wrapped.Syrk(true), expected.Syrk(true));
+  EXPECT_EQ(wrapped.SolveLeastSquares(IdentityMatrix(6)),
+            expected.SolveLeastSquares(IdentityMatrix(6)));
+  S21Matrix q, r;
+  wrapped.QrDecomposition(q, r);
+  EXPECT_EQ(q * r, expected);
+  S21Matrix square(buffer.data(), 5, 5, 8);
+  EXPECT_DOUBLE_EQ(square.Determinant(), S21Matrix(square).Determinant());
+  EXPECT_EQ(square * square.InverseMatrix(), IdentityMatrix(5));
+  S21Matrix copy(wrapped);
+  copy(0, 0) = 100.0;
+  EXPECT_NE(buffer[0], 100.0);
+  EXPECT_THROW(S21Matrix(buffer.data(), 6, 5, 4), std::runtime_error);
+  EXPECT_THROW(S21Matrix(static_cast<double*>(nullptr), 2, 2),
+               std::runtime_error);
+}
+
+TEST(S21MatrixWrapTest, FunctionsWriteIntoWrappedResult) {
+  S21Matrix a = FilledMatrix(5, 5, 92) * 0.2, b = FilledMatrix(5, 5, 93) * 0.2;
+  std::vector<double> coefficients = {1.0, -0.5, 0.25, 2.0};
+  std::vector<double> buffer(5 * 7, -1.0);
+  S21Matrix result(buffer.data(), 5, 5, 7);
+  S21Workspace workspace;
+  a.Expm(result, workspace);
+  EXPECT_EQ(result, a.Expm());
+  EXPECT_DOUBLE_EQ(buffer[7], a.Expm()(1, 0));
+  EXPECT_DOUBLE_EQ(buffer[5], -1.0);
+  // The buffer must not have become scratch of the workspace.
+  std::vector<double> kept(buffer);
+  S21Matrix other;
+  b.Expm(other, workspace);
+  b.Polynomial(coefficients, other, workspace);
+  EXPECT_EQ(buffer, kept);
+  a.Polynomial(coefficients, result, workspace);
+  EXPECT_EQ(result, a.Polynomial(coefficients));
+  EXPECT_DOUBLE_EQ(buffer[7], a.Polynomial(coefficients)(1, 0));
+  kept = buffer;
+  b.Polynomial(coefficients, other, workspace);
+  EXPECT_EQ(buffer, kept);
+}
+
+TEST(S21MatrixWrapTest, DeleterAndReadOnlyBuffers) {
+  int deleted = 0;
+  double* data = new double[4]{4.0, 2.0, 2.0, 3.0};
+  {
+    S21Matrix owner(data, 2, 2, 0, [&deleted](double* elements) {
+      deleted++;
+      delete[] elements;
+    });
+    EXPECT_EQ(owner.Cholesky() * owner.Cholesky().Transpose(), owner);
+    S21Matrix moved(std::move(owner));
+    EXPECT_DOUBLE_EQ(moved(1, 1), 3.0);
+    EXPECT_EQ(deleted, 0);
+  }
+  EXPECT_EQ(deleted, 1);
+  const double frame[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  S21Matrix view(frame, 2, 3);
+  EXPECT_DOUBLE_EQ(view.get_element_matrix_(1, 0), 4.0);
+  view.SumMatrix(view);
+  view(0, 0) = -1.0;
+  EXPECT_DOUBLE_EQ(view(1, 2), 12.0);
+  EXPECT_DOUBLE_EQ(frame[0], 1.0);
+  EXPECT_DOUBLE_EQ(frame[5], 6.0);
+}
+
+TEST(S21CopyOnWriteTest, CopiesShareUntilWritten) {
+  S21Matrix original = SymmetricMatrix(40, 92);
+  original.MulMatrix(original);
+  for (int i = 0; i < 40; i++) original(i, i) += 100.0;
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix a(original);
+  S21Matrix assigned(1, 1);
+  std::int64_t live = S21Memory::Global().live_bytes;
+  S21Matrix copy(a);
+  assigned = a;
+  EXPECT_EQ(S21Memory::Global().live_bytes, live - 8 - 8);
+  EXPECT_EQ(copy, a);
+  copy(0, 0) = -5.0;
+  assigned.MulNumber(2.0);
+  EXPECT_EQ(a, original);
+  EXPECT_DOUBLE_EQ(copy(0, 0), -5.0);
+  EXPECT_EQ(assigned, original * 2.0);
+  EXPECT_EQ(a + a, original * 2.0);
+  S21Matrix q, r;
+  S21Matrix(a).QrDecomposition(q, r);
+  EXPECT_EQ(q * r, original);
+  EXPECT_EQ(S21Matrix(a).Cholesky() * a.Cholesky().Transpose(), original);
+  EXPECT_EQ(a.Pow(-1) * a.Pow(2), a);
+  EXPECT_EQ(S21Matrix(a).SymmetricEigenvalues(),
+            original.SymmetricEigenvalues());
+  S21Workspace workspace;
+  S21Matrix exponential = (a * 1e-3).Expm();
+  S21Matrix again(exponential);
+  (a * 2e-3).Expm(again, workspace);
+  EXPECT_EQ(exponential, (original * 1e-3).Expm());
+  S21InverseUpdater updater(a);
+  updater.RankOneUpdate(std::vector<double>(40, 0.5),
+                        std::vector<double>(40, 0.25));
+  S21MaintainedProduct product(a, a);
+  S21Matrix snapshot = product.Product();
+  product.SetB(1, 2, 7.0);
+  product.Product();
+  EXPECT_EQ(snapshot, original * original);
+  EXPECT_EQ(a, original);
+  S21Matrix::SetCopyOnWrite(false);
+  S21Matrix deep(a);
+  deep(1, 1) = 0.0;
+  EXPECT_EQ(a, original);
+}
+
+TEST(S21CopyOnWriteTest, ReadersShareSnapshot) {
+  S21Matrix::SetCopyOnWrite(true);
+  const S21Matrix snapshot = FilledMatrix(64, 64, 93);
+  const S21Matrix expected = snapshot * snapshot;
+  std::vector<std::thread> readers;
+  std::vector<int> matches(4, 0);
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&, t] {
+      for (int round = 0; round < 20; round++) {
+        S21Matrix copy(snapshot);
+        if (t == 0) copy.MulNumber(3.0);
+        if (t > 0 && copy * snapshot == expected) matches[t]++;
+      }
+    });
+  }
+  for (std::thread& reader : readers) reader.join();
+  S21Matrix::SetCopyOnWrite(false);
+  EXPECT_EQ(matches, std::vector<int>({0, 20, 20, 20}));
+  EXPECT_EQ(snapshot * snapshot, expected);
+}
+
+TEST(S21CopyOnWriteTest, ReferencesStopSharing) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix a(2, 2);
+  a.set_element_matrix_(0, 0, 1.0);
+  double& element = a(0, 0);
+  S21Matrix b(a);
+  S21Matrix c(1, 1);
+  c = a;
+  element = 9.0;
+  EXPECT_DOUBLE_EQ(b(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(c(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(a(0, 0), 9.0);
+  std::string path = testing::TempDir() + "s21_cow_stream.csv";
+  FilledMatrix(4, 3, 94).SaveCsv(path);
+  std::vector<S21Matrix> kept;
+  S21Matrix::StreamCsv(path, 2, [&](const S21Matrix& block, int) {
+    kept.push_back(block);
+  });
+  S21Matrix::SetCopyOnWrite(false);
+  ASSERT_EQ(kept.size(), 2u);
+  S21Matrix loaded = S21Matrix::LoadCsv(path);
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_EQ(kept[i / 2].get_element_matrix_(i % 2, j),
+                loaded.get_element_matrix_(i, j));
+  std::remove(path.c_str());
+}
@@ -0,0 +1,13 @@
+#include <iostream>
+
+#include "s21_tuner.hpp"
+
+// `make tune`: benchmarks this machine and writes its tuning profile.
+int main() {
+  S21Tuner tuner(&std::cout);
+  s21_tuning_t tuning = tuner.Run();
+  std::string path = S21Tuner::ProfilePath();
+  S21Tuner::Save(tuning, path);
+  std::cout << "profile written to " << path << "\n";
+  return 0;
+}